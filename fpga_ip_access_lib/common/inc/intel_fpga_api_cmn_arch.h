@@ -0,0 +1,106 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Hint to the CPU that the caller is spinning on a condition, e.g. a status register.
+static inline void common_cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+// MMIO ordering barriers.
+//   common_mmio_wmb()          : all prior stores, to memory or MMIO, complete before any later store.
+//   common_mmio_rmb()          : all prior loads, from memory or MMIO, complete before any later load.
+//   common_mmio_mb()           : all prior loads and stores complete before any later load or store.
+//   common_mmio_before_write() : prior memory stores, e.g. to a DMA buffer, are visible before the following MMIO write.
+//   common_mmio_after_read()   : the preceding MMIO read completes before the following memory loads.
+// x86 orders uncached MMIO with memory accesses already, so the last two only need to stop the compiler there.
+#if defined(__x86_64__) || defined(__i386__)
+#define COMMON_MMIO_WMB             "sfence"
+#define COMMON_MMIO_RMB             "lfence"
+#define COMMON_MMIO_MB              "mfence"
+#define COMMON_MMIO_BEFORE_WRITE    ""
+#define COMMON_MMIO_AFTER_READ      ""
+#elif defined(__aarch64__)
+#define COMMON_MMIO_WMB             "dsb st"
+#define COMMON_MMIO_RMB             "dsb ld"
+#define COMMON_MMIO_MB              "dsb sy"
+#define COMMON_MMIO_BEFORE_WRITE    "dmb oshst"
+#define COMMON_MMIO_AFTER_READ      "dmb oshld"
+#elif defined(__riscv)
+#define COMMON_MMIO_WMB             "fence ow,ow"
+#define COMMON_MMIO_RMB             "fence ir,ir"
+#define COMMON_MMIO_MB              "fence iorw,iorw"
+#define COMMON_MMIO_BEFORE_WRITE    "fence w,o"
+#define COMMON_MMIO_AFTER_READ      "fence i,r"
+#endif
+
+#ifdef COMMON_MMIO_MB
+#define COMMON_MMIO_BARRIER(insn)   __asm__ __volatile__(insn ::: "memory")
+#else
+#define COMMON_MMIO_BARRIER(insn)   __sync_synchronize()
+#endif
+
+static inline void common_mmio_wmb()
+{
+    COMMON_MMIO_BARRIER(COMMON_MMIO_WMB);
+}
+
+static inline void common_mmio_rmb()
+{
+    COMMON_MMIO_BARRIER(COMMON_MMIO_RMB);
+}
+
+static inline void common_mmio_mb()
+{
+    COMMON_MMIO_BARRIER(COMMON_MMIO_MB);
+}
+
+static inline void common_mmio_before_write()
+{
+    COMMON_MMIO_BARRIER(COMMON_MMIO_BEFORE_WRITE);
+}
+
+static inline void common_mmio_after_read()
+{
+    COMMON_MMIO_BARRIER(COMMON_MMIO_AFTER_READ);
+}
+
+#ifdef __cplusplus
+}
+#endif
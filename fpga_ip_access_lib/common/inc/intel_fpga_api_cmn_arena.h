@@ -0,0 +1,69 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Size of the chunks the arena is grown by.  A request bigger than a chunk gets a chunk of its own.
+#ifndef COMMON_ARENA_CHUNK_SIZE
+#ifdef ZEPHYR_FPGA_IP_ACCESS
+#define COMMON_ARENA_CHUNK_SIZE 256
+#else
+#define COMMON_ARENA_CHUNK_SIZE 4096
+#endif
+#endif
+
+struct COMMON_ARENA_CHUNK;
+
+// Bump allocator: the allocations are zeroed, 64-bit aligned and never freed individually, but all at once by
+// common_arena_release_in().  A zeroed COMMON_ARENA is empty.
+typedef struct
+{
+    struct COMMON_ARENA_CHUNK   *head;          // Chunk being filled; the older chunks follow
+    size_t                      footprint;      // Bytes currently obtained from malloc, chunk headers included
+} COMMON_ARENA;
+
+void *common_arena_alloc_in(COMMON_ARENA *arena, size_t size);
+void common_arena_release_in(COMMON_ARENA *arena);
+void common_arena_move(COMMON_ARENA *to, COMMON_ARENA *from);  // from is left empty
+
+// The arena holding the parameter blocks and data of the interface information.  common_arena_release() frees them,
+// which common_fpga_interface_info_vec_resize(0) does.  common_arena_adopt() moves the chunks of another arena, e.g. the
+// one of a DFL scan context whose interfaces are merged, into it and leaves that arena empty.
+void *common_arena_alloc(size_t size);
+void common_arena_release();
+void common_arena_adopt(COMMON_ARENA *arena);
+size_t common_arena_footprint();
+
+#ifdef __cplusplus
+}
+#endif
@@ -28,18 +28,152 @@
 
 #include "intel_fpga_api_cmn_msg.h"
 #include "intel_fpga_api_cmn_inf.h"
+#include "intel_fpga_api_cmn_arena.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Bit 0 of the first 64-bit data word of the MMIO access parameter is set when 64-bit accesses must be split into two
+// 32-bit accesses, e.g. behind the Intel FPGA PCIe Memory Mapped Bridge IP.  The DFH specification allocates no ID for
+// this parameter, so the design picks one and passes it to common_dfl_set_mmio_access_param_id().
+#define DFL_PARAM_MMIO_ACCESS_EMULATE_64BIT (1ULL << 0)
+
+#define DFL_ROM_SNAPSHOT_MAX_REGIONS 16
+
 typedef unsigned int FPGA_INTERFACE_INDEX;
 typedef uint64_t (*FPGA_DFL_BASE_ADDR_DECODER)(uint64_t);
 
+// DFH list waiting to be walked
+typedef struct
+{
+    void    *dfh_addr;      // Next DFH to visit
+    int     dfh_parent;     // Index of the interface owning the branch; -1 on the top level
+    size_t  depth;          // Number of branches followed from the top level
+    size_t  dfl_size;       // Size of the DFL given by the branch parameter; 0 when not given
+} DFL_WALK_ITEM;
+
+// Host memory copy of a region of the DFL ROM
+typedef struct
+{
+    uint8_t *rom;       // Start of the copied region in the device address space
+    uint8_t *copy;      // Host memory copy
+    size_t  size;
+} DFL_ROM_SNAPSHOT_REGION;
+
+// State and output of DFL walks.  A walk only touches its own context, so several DFLs, e.g. of several cards, can be
+// walked concurrently on different threads, one context each, and merged into the interface table once they are done.
+typedef struct
+{
+    // Settings, taken from the common_dfl_set_*() values by common_dfl_scan_ctx_init(); they may be changed before a walk
+    uint8_t                     *range_begin;
+    size_t                      range_size;                     // 0 leaves the DFL addresses unchecked
+    size_t                      max_depth;
+    size_t                      max_interfaces;
+    bool                        rom_snapshot;
+    size_t                      rom_snapshot_size;
+    bool                        param_views;                    // Parameter data point into the ROM snapshot, which then lives in the arena
+    size_t                      num_workers;                    // Threads walking the branches; 0 or 1 walks serially
+
+    // Set when the context walks a branch of another DFL: the depth of the branch and the DFH owning it, which counts
+    // as an ancestor for the loop detection
+    size_t                      root_depth;
+    void                        *root_parent_dfh_address;
+
+    // Walk the first DFH and its branches only, not the rest of its list
+    bool                        subtree_only;
+
+    // Set when the walk stopped at max_depth or max_interfaces, so that its output does not describe the whole DFL
+    bool                        is_truncated;
+
+    // Interfaces found so far, numbered from 0; their parameters live in the arena of the context
+    FPGA_INTERFACE_INFO         *interfaces;
+    size_t                      num_interfaces;
+    size_t                      interfaces_reserved;
+    COMMON_ARENA                arena;
+
+    // Pending DFH lists.  Each visited interface pushes the rest of its list, then its branches, so that the branches
+    // are walked first and the interfaces are numbered in depth-first order.
+    DFL_WALK_ITEM               *walk_stack;
+    size_t                      walk_stack_size;
+    size_t                      walk_stack_reserved;
+
+    // With defer_branches, the branches are collected here instead of being walked
+    bool                        defer_branches;
+    DFL_WALK_ITEM               *branches;
+    size_t                      num_branches;
+    size_t                      branches_reserved;
+
+    // Parameter blocks of the interface being walked, collected here until the interface is complete and then moved
+    // to the arena in one piece
+    FPGA_INTERFACE_PARAMETER    *param_scratch;
+    size_t                      param_scratch_count;
+    size_t                      param_scratch_reserved;
+    uint64_t                    *param_data_scratch;            // Data of all the parameter blocks, back to back
+    size_t                      param_data_scratch_used;        // in 64-bit words
+    size_t                      param_data_scratch_reserved;    // in 64-bit words
+
+    // The walk reads the DFL ROM through these copies when the ROM snapshot is enabled.  With param_views, the copies
+    // are allocated from the arena and are not freed after the walk.
+    DFL_ROM_SNAPSHOT_REGION     rom_snapshot_regions[DFL_ROM_SNAPSHOT_MAX_REGIONS];
+    size_t                      rom_snapshot_region_count;
+} FPGA_DFL_SCAN_CTX;
+
+// common_dfl_scan_ctx_walk() appends the interfaces of the DFL at first_dfh_addr to the context.
+// common_dfl_scan_ctx_merge() moves them to the end of the interface table and returns the index of the first one; it
+// must not run concurrently with another merge or with the API, and common_index_build() must follow the last merge.
+// common_dfl_scan_ctx_cleanup() frees the context, including the interfaces not merged.
+void common_dfl_scan_ctx_init(FPGA_DFL_SCAN_CTX *ctx);
+void common_dfl_scan_ctx_walk(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr);
+FPGA_INTERFACE_INDEX common_dfl_scan_ctx_merge(FPGA_DFL_SCAN_CTX *ctx);
+void common_dfl_scan_ctx_cleanup(FPGA_DFL_SCAN_CTX *ctx);
+
 void common_dfl_scan_multi_interfaces(void *dfh_base_addr, FPGA_DFL_BASE_ADDR_DECODER base_addr_decoder);
 void common_dfl_print_all_interfaces(FPGA_DFL_BASE_ADDR_DECODER base_addr_decoder);
 void common_dfl_print_interface(FPGA_INTERFACE_INDEX index, FPGA_DFL_BASE_ADDR_DECODER base_addr_decoder);
 
+// Decoder of the base addresses reported by fpga_dfl_export(); common_dfl_scan_multi_interfaces() sets it to its own.
+// NULL reports the mapped addresses.
+void common_dfl_set_base_addr_decoder(FPGA_DFL_BASE_ADDR_DECODER base_addr_decoder);
+uint64_t common_dfl_decode_base_address(const void *base_address);
+
+// Used internally to sort the parameters of an interface for fpga_get_parameter() once they are all collected.  The order
+// is allocated from arena, or from the arena of the interface table when arena is NULL.
+void common_dfl_param_order_build(FPGA_INTERFACE_INFO *info, COMMON_ARENA *arena);
+
+// Split the 64-bit reads of the DFL ROM, and by default the 64-bit accesses of the scanned interfaces, into two 32-bit
+// accesses.  An MMIO access parameter overrides the default of its interface.
+extern bool g_common_dfl_emulate_64bit;
+void common_dfl_set_64bit_emulation(bool enable);
+
+// Parameter ID read as the MMIO access parameter of the scanned interfaces.  0, the default, ignores the parameter, so that
+// only common_dfl_set_64bit_emulation() and fpga_set_64bit_emulation() select the emulation.
+void common_dfl_set_mmio_access_param_id(uint16_t param_id);
+
+// Copy the DFL ROM into host memory with block reads before it is parsed.  The top-level DFL is copied from the entry
+// address over size bytes; with size 0, and for branches without a size, the copy spans from the first to the last DFH of
+// the list.  Only use this when the ROM region has no read side-effect.
+void common_dfl_set_rom_snapshot(bool enable, size_t size);
+
+// Keep the ROM snapshot for the lifetime of the interface table and let the parameter data point into it instead of
+// copying them.  This enables the ROM snapshot; a parameter block outside of the snapshot is still copied.
+void common_dfl_set_param_views(bool enable);
+
+// Load the interface table from the cache file at path instead of walking the DFL when the file matches the DFL, and
+// write the file after a walk otherwise.  NULL disables the cache.  See intel_fpga_api_cmn_dfl_cache.h.
+void common_dfl_set_cache_path(const char *path);
+
+// Bound the DFL walk, so that a corrupted DFL cannot hang or crash the scan.  The walk reads nothing outside of the size
+// bytes from begin; size 0 leaves the addresses unchecked.  It follows at most max_depth levels of branches and stops after
+// max_interfaces interfaces; 0 selects the default limit.  A DFH reached again through one of its own branches ends
+// the list it is reached from.  Each case is reported with a warning and the interfaces found so far are kept.
+void common_dfl_set_address_range(void *begin, size_t size);
+void common_dfl_set_scan_limits(size_t max_depth, size_t max_interfaces);
+
+// Walk the top-level list first, then the subtree of each of its branches on a pool of num_workers threads; 0 or 1
+// walks serially.  The interfaces are numbered as by the serial walk.  Ignored on Zephyr.
+void common_dfl_set_scan_workers(size_t num_workers);
+
 #ifdef FPGA_IP_ACCESS_COMMON_DFL_USE_CUSTOM_MMIO_READ_FUNC
 #include "intel_fpga_platform_api_sim.h"
 // Targeting simulation platform
@@ -73,19 +207,22 @@ static inline uint32_t common_dfl_read_32(void *begin_address, uint32_t offset)
 static inline uint64_t common_dfl_read_64(void *begin_address, uint32_t offset)
 {
 #ifndef FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT
+    if (!__builtin_expect(g_common_dfl_emulate_64bit, 0))
+    {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpragmas"
 #pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
-    return *((volatile uint64_t *)((volatile uint8_t *)begin_address + offset));
+        return *((volatile uint64_t *)((volatile uint8_t *)begin_address + offset));
 #pragma GCC diagnostic pop
-#else
+    }
+#endif // FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT
+
     // This emulation is needed when Intel FPGA PCIe Memory Mapped Bridge IP is used to implement the PCIe function.
     // Little-endian system is assumed.
     uint64_t data = common_dfl_read_32(begin_address, offset);
     data |= (uint64_t)common_dfl_read_32(begin_address, offset + 4) << 32;
 
     return data;
-#endif // FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT
 }
 
 #endif // FPGA_IP_ACCESS_COMMON_DFL_USE_CUSTOM_MMIO_READ_FUNC
@@ -0,0 +1,92 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Layout of the binary image written by fpga_dfl_export() with FPGA_DFL_EXPORT_BINARY, and of the DFL cache file: a
+// DFL_EXPORT_HEADER, then for each interface in index order a DFL_EXPORT_INTERFACE followed by its parameters, each a
+// DFL_EXPORT_PARAMETER followed by data_size bytes of data.  All records are multiples of 8 bytes and little-endian.
+// fpga_dfl_export() writes the addresses decoded by the base address decoder of the platform; dfh_parent is an interface
+// index, -1 on the top level.
+#define DFL_EXPORT_MAGIC            0x584c464441475046ULL   // "FPGADFLX"
+#define DFL_EXPORT_VERSION          2
+#define DFL_EXPORT_REMOVED          (1 << 0)                // Removed by fpga_dfl_rescan(); kept so that the indices match
+#define DFL_EXPORT_EMULATE_64BIT    (1 << 1)
+#define DFL_EXPORT_DFL              (1 << 2)                // Discovered from a DFL
+#define DFL_EXPORT_ABSOLUTE_BASE    (1 << 3)                // DFL_EXPORT_ADDR_RELATIVE only: base_address is absolute
+
+typedef struct
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t num_of_interfaces;
+    uint64_t key;               // Validation key of the DFL cache; 0 in fpga_dfl_export() images
+    uint64_t size;              // Image size in bytes
+    uint64_t checksum;          // Hash of the bytes following the header
+} DFL_EXPORT_HEADER;
+
+typedef struct
+{
+    uint64_t guid_l;
+    uint64_t guid_h;
+    uint64_t dfh_address;       // 0 for an interface not discovered from a DFL
+    uint64_t base_address;
+    int32_t  dfh_parent;
+    uint16_t instance_id;
+    uint16_t group_id;
+    uint32_t flags;
+    uint32_t num_of_parameters;
+} DFL_EXPORT_INTERFACE;
+
+typedef struct
+{
+    uint16_t version;
+    uint16_t param_id;
+    uint32_t data_size;
+} DFL_EXPORT_PARAMETER;
+
+typedef enum
+{
+    DFL_EXPORT_ADDR_DECODED,        // Decoded by the base address decoder of the platform
+    DFL_EXPORT_ADDR_RELATIVE        // Relative to the entry DFH, unless DFL_EXPORT_ABSOLUTE_BASE is set
+} DFL_EXPORT_ADDR_ENCODING;
+
+// Used internally to write the image of the interface table to path, atomically.  first_dfh_addr is the entry DFH of
+// DFL_EXPORT_ADDR_RELATIVE.  Not available on Zephyr.
+bool common_dfl_export_save(const char *path, uint64_t magic, uint64_t key, DFL_EXPORT_ADDR_ENCODING encoding, void *first_dfh_addr);
+
+#ifdef __cplusplus
+}
+#endif
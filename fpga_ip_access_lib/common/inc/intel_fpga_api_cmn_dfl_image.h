@@ -0,0 +1,65 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdint.h>
+#include "intel_fpga_api_cmn_dfl.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Offline DFL ROM images, to analyse or replay the DFL walk of a card without the card.  DFL_IMAGE_RAW is a binary copy
+// of the ROM from the entry DFH; DFL_IMAGE_TEXT is the dfl_rom.txt dump written by the walker with DFL_WALKER_DEBUG_MODE.
+// DFL_IMAGE_AUTO picks the text format when the file starts like a dump.
+// Not available on Zephyr.
+typedef enum
+{
+    DFL_IMAGE_AUTO = 0,
+    DFL_IMAGE_RAW,
+    DFL_IMAGE_TEXT
+} DFL_IMAGE_FORMAT;
+
+// Load the image at path into a private memory mapping and scan it with common_dfl_scan_multi_interfaces(), bounded to
+// the image.  The base addresses are decoded as base_address plus their offset in the image, so that base_address
+// should be the offset of the entry DFH given by the platform decoder on the card.  The interfaces may be accessed through
+// the API like mapped interfaces: reads return the image and writes change the mapping only.  An absolute branch or CSR
+// address refers to the address space of the process, so it cannot point into the image and is reported out of range.
+// Returns the number of interfaces, or -1 when the file cannot be loaded.  The image stays loaded until
+// common_dfl_image_unload() or the next load.
+int common_dfl_image_scan(const char *path, DFL_IMAGE_FORMAT format, uint64_t base_address);
+
+// Clear the interface table and release the image
+void common_dfl_image_unload();
+
+// Base address decoder of the loaded image
+uint64_t common_dfl_image_base_addr_decoder(uint64_t base_addr);
+
+#ifdef __cplusplus
+}
+#endif
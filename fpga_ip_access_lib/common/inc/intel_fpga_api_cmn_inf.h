@@ -36,12 +36,39 @@
 extern "C" {
 #endif
 
+typedef enum
+{
+    FPGA_DFL_RESCAN_ADDED,          // Appended to the interface table
+    FPGA_DFL_RESCAN_REMOVED,        // Left in the table as removed; it cannot be opened any more
+    FPGA_DFL_RESCAN_CHANGED         // Updated in place; the open handles and the registered ISR are kept
+} FPGA_DFL_RESCAN_EVENT;
+typedef void (*FPGA_DFL_RESCAN_CALLBACK)(FPGA_DFL_RESCAN_EVENT event, unsigned int index, void *context);
+
+typedef enum
+{
+    FPGA_DFL_EXPORT_BINARY,         // See intel_fpga_api_cmn_dfl_export.h
+    FPGA_DFL_EXPORT_JSON
+} FPGA_DFL_EXPORT_FORMAT;
+
 unsigned int fpga_get_num_of_interfaces();
 bool fpga_get_interface_at(unsigned int index, FPGA_INTERFACE_INFO *info);
+const FPGA_INTERFACE_INFO *fpga_interface_view(unsigned int index);
+int fpga_find_interface(const FPGA_INTERFACE_GUID *guid, uint16_t instance_id);
+unsigned int fpga_find_all_by_guid(const FPGA_INTERFACE_GUID *guid, unsigned int *indices, unsigned int max_indices);
+unsigned int fpga_get_group_members(uint16_t group_id, unsigned int *indices, unsigned int max_indices);
+unsigned int fpga_get_children(unsigned int index, unsigned int *indices, unsigned int max_indices);
+int fpga_get_next_in_tree(int root, int index);
+const FPGA_INTERFACE_PARAMETER *fpga_get_parameter(unsigned int index, uint16_t param_id, uint16_t version_min);
+int fpga_dfl_rescan(unsigned int parent_index, FPGA_DFL_RESCAN_CALLBACK callback, void *context);
+int fpga_dfl_export(const char *path, FPGA_DFL_EXPORT_FORMAT format);
 FPGA_MMIO_INTERFACE_HANDLE fpga_open(unsigned int index);
 void fpga_close(unsigned int index);
 FPGA_INTERRUPT_HANDLE fpga_interrupt_open(unsigned int index);
 void fpga_interrupt_close(unsigned int index);
+int fpga_set_64bit_emulation(FPGA_MMIO_INTERFACE_HANDLE handle, bool enable);
+int fpga_lock(FPGA_MMIO_INTERFACE_HANDLE handle);
+int fpga_trylock(FPGA_MMIO_INTERFACE_HANDLE handle);
+int fpga_unlock(FPGA_MMIO_INTERFACE_HANDLE handle);
 
 
 // This API with pre-fix common_fpga_interface_info_vec implements C++ vector semantics without exception handling.
@@ -60,6 +87,24 @@ static inline FPGA_INTERFACE_INFO *common_fpga_interface_info_vec_at(size_t inde
 void common_fpga_interface_info_vec_resize(size_t size);
 void common_fpga_interface_info_vec_reserve(size_t size);
 
+// Used internally by the MMIO accessors: the state they need for each interface, kept in a dense array of its own
+// rather than in FPGA_INTERFACE_INFO, so that polling many interfaces keeps to a few cache lines.  The vector above
+// sizes it.  common_fpga_interface_hot_update() copies it from the interface information and must follow every write of
+// base_address or emulate_64bit, including when the interface is added to the table, so that the accessors find the
+// interface before it is opened.
+typedef struct
+{
+    volatile uint8_t             *base;
+    bool                         emulate_64bit;
+} COMMON_FPGA_INTERFACE_HOT;
+
+extern COMMON_FPGA_INTERFACE_HOT *g_common_fpga_interface_hot_vec;
+static inline COMMON_FPGA_INTERFACE_HOT *common_fpga_interface_hot_at(size_t index)
+{
+    return g_common_fpga_interface_hot_vec + index;
+}
+void common_fpga_interface_hot_update(size_t index);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,66 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "intel_fpga_platform.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    uint64_t                     reads;             //!< Register reads issued to the device
+    uint64_t                     avoided_reads;     //!< Register reads served from the shadow instead
+    uint64_t                     writes;            //!< Register writes issued to the device
+} FPGA_SHADOW_STATS;
+
+// Opt-in shadow of write-mostly CSRs.  Offsets within a declared range keep the last value written or read in host
+// memory, so that reads and read-modify-writes of those offsets issue no MMIO read.  The shadow is only coherent when
+// every write to a shadowed offset goes through fpga_shadow_write_32/64() or fpga_rmw_32/64(); use
+// fpga_shadow_invalidate() or fpga_shadow_refresh() after the hardware or another path changed the registers.
+int fpga_shadow_add_range(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t size);
+uint32_t fpga_shadow_read_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset);
+uint64_t fpga_shadow_read_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset);
+void fpga_shadow_write_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t value);
+void fpga_shadow_write_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint64_t value);
+uint32_t fpga_rmw_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t clear, uint32_t set);
+uint64_t fpga_rmw_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint64_t clear, uint64_t set);
+int fpga_shadow_invalidate(FPGA_MMIO_INTERFACE_HANDLE handle);
+int fpga_shadow_refresh(FPGA_MMIO_INTERFACE_HANDLE handle);
+int fpga_shadow_get_stats(FPGA_MMIO_INTERFACE_HANDLE handle, FPGA_SHADOW_STATS *stats);
+
+// Used internally to release the shadow of an interface when the interface is removed.
+void common_shadow_free(void *shadow);
+
+#ifdef __cplusplus
+}
+#endif
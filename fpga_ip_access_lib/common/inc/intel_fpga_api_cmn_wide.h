@@ -0,0 +1,62 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Widest CPU data path usable for MMIO, selected once at run-time from the CPU features.
+typedef enum
+{
+    COMMON_MMIO_WIDE_PATH_NONE,         // No vector path; callers fall back to 64-bit accesses
+    COMMON_MMIO_WIDE_PATH_SSE2,         // 128-bit
+    COMMON_MMIO_WIDE_PATH_AVX2,         // 256-bit
+    COMMON_MMIO_WIDE_PATH_AVX512        // 512-bit, one transaction per fpga_read_512()/fpga_write_512()
+} COMMON_MMIO_WIDE_PATH;
+
+COMMON_MMIO_WIDE_PATH common_mmio_wide_path();
+
+// Move 64 bytes between the MMIO address and value with the widest vector path the CPU and the
+// address alignment allow.  Return false without any access if no vector path applies, in which case
+// the caller is expected to fall back to 64-bit accesses.
+bool common_mmio_read_512(const volatile void *src, uint8_t *value);
+bool common_mmio_write_512(volatile void *dst, const uint8_t *value);
+
+// Copy len bytes between host memory and MMIO with the widest accesses available.  The MMIO address must be
+// 64-bit aligned and len must be a multiple of 8.  The host buffer has no alignment requirement.
+void common_mmio_copy_from_io(void *dst, const volatile void *src, size_t len);
+void common_mmio_copy_to_io(volatile void *dst, const void *src, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
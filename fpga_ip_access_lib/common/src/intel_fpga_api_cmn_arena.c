@@ -0,0 +1,142 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_arena.h"
+
+#define COMMON_ARENA_ALIGN(size) (((size) + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1))
+
+typedef struct COMMON_ARENA_CHUNK
+{
+    struct COMMON_ARENA_CHUNK    *next;
+    size_t                       size;          // Bytes available in data
+    size_t                       used;
+    uint64_t                     data[];
+} COMMON_ARENA_CHUNK;
+
+static COMMON_ARENA s_common_arena = { NULL, 0 };
+
+void *common_arena_alloc_in(COMMON_ARENA *arena, size_t size)
+{
+    COMMON_ARENA_CHUNK *chunk = arena->head;
+    void *ret;
+
+    size = COMMON_ARENA_ALIGN(size);
+    if (chunk == NULL || chunk->size - chunk->used < size)
+    {
+        size_t chunk_size = size > COMMON_ARENA_CHUNK_SIZE ? size : COMMON_ARENA_CHUNK_SIZE;
+
+        chunk = (COMMON_ARENA_CHUNK *)malloc(sizeof(COMMON_ARENA_CHUNK) + chunk_size);
+        if (chunk == NULL)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d bytes of interface information.", size);
+            return NULL;
+        }
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        arena->footprint += sizeof(COMMON_ARENA_CHUNK) + chunk_size;
+
+        // An oversized chunk is linked behind the current one so that the room left in the current one is still used.
+        if (arena->head != NULL && size > COMMON_ARENA_CHUNK_SIZE)
+        {
+            chunk->next = arena->head->next;
+            arena->head->next = chunk;
+        }
+        else
+        {
+            chunk->next = arena->head;
+            arena->head = chunk;
+        }
+    }
+
+    ret = (uint8_t *)chunk->data + chunk->used;
+    chunk->used += size;
+    memset(ret, 0, size);
+
+    return ret;
+}
+
+void common_arena_release_in(COMMON_ARENA *arena)
+{
+    while (arena->head != NULL)
+    {
+        COMMON_ARENA_CHUNK *next = arena->head->next;
+        free(arena->head);
+        arena->head = next;
+    }
+    arena->footprint = 0;
+}
+
+void *common_arena_alloc(size_t size)
+{
+    return common_arena_alloc_in(&s_common_arena, size);
+}
+
+void common_arena_release()
+{
+    common_arena_release_in(&s_common_arena);
+}
+
+void common_arena_adopt(COMMON_ARENA *arena)
+{
+    common_arena_move(&s_common_arena, arena);
+}
+
+void common_arena_move(COMMON_ARENA *to, COMMON_ARENA *from)
+{
+    if (from->head == NULL)
+    {
+        return;
+    }
+
+    // The moved chunks are linked behind the chunk being filled, which keeps its room.
+    COMMON_ARENA_CHUNK *tail = from->head;
+    while (tail->next != NULL)
+    {
+        tail = tail->next;
+    }
+    if (to->head != NULL)
+    {
+        tail->next = to->head->next;
+        to->head->next = from->head;
+    }
+    else
+    {
+        to->head = from->head;
+    }
+    to->footprint += from->footprint;
+    from->head = NULL;
+    from->footprint = 0;
+}
+
+size_t common_arena_footprint()
+{
+    return s_common_arena.footprint;
+}
@@ -27,244 +27,842 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+#include <pthread.h>
+#endif
 
 #include "intel_fpga_api_cmn_dfl.h"
 #include "intel_fpga_api_cmn_msg.h"
 #include "intel_fpga_api_cmn_inf.h"
+#include "intel_fpga_api_cmn_wide.h"
+#include "intel_fpga_api_cmn_dfl_cache.h"
+#include "intel_fpga_api_cmn_arena.h"
+#include "intel_fpga_api_cmn_index.h"
 
 #define PARAM_HEADER_SIZE 8 // 8-byte parameter header
-#define DFH_PARENT_STACK_INCR_SIZE 8
+#define DFH_HEADER_SIZE 0x28 // DFH, GUID_L, GUID_H, CSR_ADDR and CSR_SIZE_GROUP
+#define DFL_WALK_STACK_MIN_RESERVE 8     // first allocation of the walk stack; doubled whenever it is full
+#define INTERFACE_INFO_VEC_MIN_RESERVE 8 // first allocation of the interface vector; doubled whenever it is full
+#define PARAM_SCRATCH_MIN_RESERVE 8      // first allocation of the parameter scratches; doubled whenever they are full
+
+#ifndef DFL_WALK_DEFAULT_MAX_DEPTH
+#define DFL_WALK_DEFAULT_MAX_DEPTH 16
+#endif
+#ifndef DFL_WALK_DEFAULT_MAX_INTERFACES
+#ifdef ZEPHYR_FPGA_IP_ACCESS
+#define DFL_WALK_DEFAULT_MAX_INTERFACES 256
+#else
+#define DFL_WALK_DEFAULT_MAX_INTERFACES 4096
+#endif
+#endif
 
 typedef unsigned int FPGA_INTERFACE_PARAM_BLOCK_INDEX;
 typedef unsigned int FPGA_INTERFACE_PARAM_DATA_INDEX;
 
-static int dfh_parent_stack_isempty();
-static int dfh_parent_stack_peek();
-static void dfh_parent_stack_pop();
-static void dfh_parent_stack_push(int data);
-static void dfh_parent_stack_resize(size_t size);
-static void scan_the_num_interfaces(void *first_dfh_addr);
-static void dfl_collect_interfaces_info(void *first_dfh_addr);
-static uint64_t get_x_feature_dfh_start_64_data(void *current_dfh_address);
+static void dfl_walk(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr);
+static void dfl_walk_push(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr, int dfh_parent, size_t depth);
+static void dfl_walk_defer_branch(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr, int dfh_parent, size_t depth, size_t dfl_size);
+static void dfl_walk_items_reserve(DFL_WALK_ITEM **items, size_t size, size_t *reserved);
+static void dfl_scan_ctx_derive(FPGA_DFL_SCAN_CTX *derived, const FPGA_DFL_SCAN_CTX *ctx);
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+static void dfl_walk_parallel(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr);
+static void *dfl_walk_worker(void *arg);
+#endif
+static bool dfl_walk_is_on_path(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr, int dfh_parent);
+static bool dfl_in_range(FPGA_DFL_SCAN_CTX *ctx, void *addr, size_t size);
+static FPGA_INTERFACE_INDEX interface_info_vec_push_back(FPGA_DFL_SCAN_CTX *ctx);
+static uint64_t dfl_rom_read_64(FPGA_DFL_SCAN_CTX *ctx, void *begin_address, uint32_t offset);
+static bool dfl_rom_snapshot_covers(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr);
+static size_t dfl_rom_snapshot_bound(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr);
+static void dfl_rom_snapshot_add(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr, size_t size);
+static void dfl_rom_snapshot_free(FPGA_DFL_SCAN_CTX *ctx);
+static uint64_t *dfl_rom_snapshot_view(FPGA_DFL_SCAN_CTX *ctx, void *addr, size_t size);
+static uint64_t dfl_cache_key(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr);
+static uint64_t dfl_cache_key_hash_params(FPGA_DFL_SCAN_CTX *ctx, uint64_t hash, void *dfh_addr, size_t depth);
+static uint64_t get_x_feature_dfh_start_64_data(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address);
 static bool is_eol(uint64_t dfh_64_data);
 static void *get_next_dfh_addr(uint64_t dfh_64_data, void *current_dfh_address);
-static uint64_t get_x_feature_csr_group_size_64_data(void *current_dfh_address);
+static uint64_t get_x_feature_csr_group_size_64_data(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address);
 static uint64_t get_next_param_byte_offset(uint64_t param_header_64_data);
-static uint64_t get_x_feature_guid_l_64(void *current_dfh_address);
-static uint64_t get_x_feature_guid_h_64(void *current_dfh_address);
+static uint64_t get_x_feature_guid_l_64(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address);
+static uint64_t get_x_feature_guid_h_64(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address);
 static uint32_t get_next_dfh_byte_offset(uint64_t dfh_64_data);
 static void *get_first_param_header_addr(void *dfh_base_addr);
-static uint32_t get_param_id(uint64_t param_header_64_data);
 static uint16_t get_param_block_version(uint64_t param_header_64_data);
+static bool is_last_param_block(uint64_t param_header_64_data);
 static uint16_t get_param_block_param_id(uint64_t param_header_64_data);
-static uint16_t get_instance_id(void *current_dfh_address);
-static uint16_t get_group_id(void *current_dfh_address);
-static void *get_base_address(void *current_dfh_address);
+static uint16_t get_instance_id(uint64_t csr_size_group_64_data);
+static uint16_t get_group_id(uint64_t csr_size_group_64_data);
+static void *get_base_address(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address);
 static bool has_params(uint64_t csr_size_group_64_data);
-static void handle_well_known_param_id(void *current_dfh_addr, void *current_param_block_addr, int param_id, bool collect_interfaces);
-static void process_param_list_for_known_param_id(void *current_dfh_addr, void *current_param_block_addr, bool collect_interfaces);
-static void deal_with_interface_at_current_level(void *current_dfh_addr, bool collect_interfaces);
-static void param_block_init(FPGA_INTERFACE_INDEX index);
-static void param_block_resize(FPGA_INTERFACE_INDEX index, size_t size);
-static void param_data_allocate(FPGA_INTERFACE_INDEX index, FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index, size_t size);
-static void set_parameter_properties(FPGA_INTERFACE_INDEX index, void *dfh_addr);
-static void set_interface_properties(FPGA_INTERFACE_INDEX index, void *dfh_addr);
+static void *get_branch_dfl_addr(uint64_t branch_dfl_64_data, void *current_dfh_addr);
+static void handle_branch_param_id(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *current_dfh_addr, FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index, size_t depth);
+static void handle_well_known_param_id(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *current_dfh_addr, FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index, size_t depth);
+static void process_param_list_for_known_param_id(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *current_dfh_addr, size_t depth);
+static void param_scratch_resize(FPGA_DFL_SCAN_CTX *ctx, size_t size);
+static void param_data_scratch_append(FPGA_DFL_SCAN_CTX *ctx, void *param_data_addr, size_t size);
+static void param_scratch_commit(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index);
+static void set_parameter_properties(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *dfh_addr, uint64_t csr_size_group_64_data);
+static void set_interface_properties(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *dfh_addr, int dfh_parent);
+static bool get_64bit_emulation(const FPGA_INTERFACE_INFO *info);
 void dfl_walker_clean_up(); // celan up memory allocated for parameter block;
 
-static int s_scanned_interface_count;
-static int s_interface_index = 0;
+bool g_common_dfl_emulate_64bit = false;
+static uint16_t s_dfl_mmio_access_param_id = 0;
 
-// used to get the dfh_parent info
-typedef struct
+// Settings copied into each scan context by common_dfl_scan_ctx_init()
+static bool s_dfl_rom_snapshot = false;
+static size_t s_dfl_rom_snapshot_size = 0;
+static bool s_dfl_param_views = false;
+static uint8_t *s_dfl_range_begin = NULL;
+static size_t s_dfl_range_size = 0;
+static size_t s_dfl_max_depth = DFL_WALK_DEFAULT_MAX_DEPTH;
+static size_t s_dfl_max_interfaces = DFL_WALK_DEFAULT_MAX_INTERFACES;
+static size_t s_dfl_num_workers = 0;
+
+static const char *s_dfl_cache_path = NULL;
+static FPGA_DFL_BASE_ADDR_DECODER s_dfl_base_addr_decoder = NULL;
+
+void common_dfl_set_64bit_emulation(bool enable)
+{
+    g_common_dfl_emulate_64bit = enable;
+}
+
+void common_dfl_set_mmio_access_param_id(uint16_t param_id)
+{
+    s_dfl_mmio_access_param_id = param_id;
+}
+
+void common_dfl_set_rom_snapshot(bool enable, size_t size)
+{
+    s_dfl_rom_snapshot = enable;
+    s_dfl_rom_snapshot_size = size;
+}
+
+void common_dfl_set_param_views(bool enable)
+{
+    s_dfl_param_views = enable;
+}
+
+void common_dfl_set_cache_path(const char *path)
 {
-    int *head;
-    int top;
-    int size;
-} DFH_PARENT_STACK;
+    s_dfl_cache_path = path;
+}
 
-const DFH_PARENT_STACK DFH_PARENT_STACK_default = {
-    .head = NULL,
-    .top = -1,
-    .size = 0};
+void common_dfl_set_base_addr_decoder(FPGA_DFL_BASE_ADDR_DECODER base_addr_decoder)
+{
+    s_dfl_base_addr_decoder = base_addr_decoder;
+}
 
-DFH_PARENT_STACK dfh_parent_stack;
+uint64_t common_dfl_decode_base_address(const void *base_address)
+{
+    return s_dfl_base_addr_decoder != NULL ? s_dfl_base_addr_decoder((uint64_t)(uintptr_t)base_address) : (uint64_t)(uintptr_t)base_address;
+}
 
-static void dfh_parent_stack_resize(size_t size)
+void common_dfl_set_address_range(void *begin, size_t size)
 {
-    if (size > (size_t)dfh_parent_stack.size)
+    s_dfl_range_begin = (uint8_t *)begin;
+    s_dfl_range_size = size;
+}
+
+void common_dfl_set_scan_limits(size_t max_depth, size_t max_interfaces)
+{
+    s_dfl_max_depth = max_depth > 0 ? max_depth : DFL_WALK_DEFAULT_MAX_DEPTH;
+    s_dfl_max_interfaces = max_interfaces > 0 ? max_interfaces : DFL_WALK_DEFAULT_MAX_INTERFACES;
+}
+
+void common_dfl_set_scan_workers(size_t num_workers)
+{
+    s_dfl_num_workers = num_workers;
+}
+
+void common_dfl_scan_multi_interfaces(void *first_dfh_addr, FPGA_DFL_BASE_ADDR_DECODER base_addr_decoder)
+{
+    FPGA_DFL_SCAN_CTX ctx;
+
+    common_fpga_interface_info_vec_resize(0);
+    common_dfl_set_base_addr_decoder(base_addr_decoder);
+    common_dfl_scan_ctx_init(&ctx);
+#ifdef DFL_WALKER_DEBUG_MODE
+    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Start Scanning Interface...");
+#endif
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+    uint64_t cache_key = 0;
+    bool is_cached = false;
+    if (s_dfl_cache_path != NULL)
     {
-        dfh_parent_stack.head = realloc(dfh_parent_stack.head, size * sizeof(int));
-        if (dfh_parent_stack.head == NULL)
-        {
-            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d DFH Parent Stack.", size);
-        }
-        else
-        {
-            memset(dfh_parent_stack.head + dfh_parent_stack.size, 0, ((size - dfh_parent_stack.size) * sizeof(int)));
-            dfh_parent_stack.size = size;
-        }
+        cache_key = dfl_cache_key(&ctx, first_dfh_addr);
+        is_cached = common_dfl_cache_load(s_dfl_cache_path, first_dfh_addr, cache_key);
     }
-    else if (size == 0)
+    if (!is_cached)
+#endif
     {
-        if (dfh_parent_stack.head != NULL)
+        common_dfl_scan_ctx_walk(&ctx, first_dfh_addr);
+        common_dfl_scan_ctx_merge(&ctx);
+
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+        // a walk stopped at a limit is not cached, so that raising the limit or fixing the DFL takes effect
+        if (s_dfl_cache_path != NULL && !ctx.is_truncated)
         {
-            free(dfh_parent_stack.head);
+            common_dfl_cache_save(s_dfl_cache_path, first_dfh_addr, cache_key);
         }
-        dfh_parent_stack.head = NULL;
-        dfh_parent_stack.size = 0;
+#endif
     }
-    else if (size < dfh_parent_stack.size)
+    common_dfl_scan_ctx_cleanup(&ctx);
+
+    common_index_build();
+
+#ifdef DFL_WALKER_REPORT
+    fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "===========================");
+    fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "MMIO Interface(s) registered: %d", common_fpga_interface_info_vec_size());
+    common_dfl_print_all_interfaces(base_addr_decoder);
+#endif
+}
+
+void common_dfl_scan_ctx_init(FPGA_DFL_SCAN_CTX *ctx)
+{
+    memset(ctx, 0, sizeof(FPGA_DFL_SCAN_CTX));
+    ctx->range_begin = s_dfl_range_begin;
+    ctx->range_size = s_dfl_range_size;
+    ctx->max_depth = s_dfl_max_depth;
+    ctx->max_interfaces = s_dfl_max_interfaces;
+    ctx->rom_snapshot = s_dfl_rom_snapshot || s_dfl_param_views;
+    ctx->rom_snapshot_size = s_dfl_rom_snapshot_size;
+    ctx->param_views = s_dfl_param_views;
+    ctx->num_workers = s_dfl_num_workers;
+}
+
+void common_dfl_scan_ctx_walk(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr)
+{
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+    if (ctx->num_workers > 1 && !ctx->defer_branches)
+    {
+        dfl_rom_snapshot_free(ctx);     // each worker context takes its own snapshot
+        dfl_walk_parallel(ctx, first_dfh_addr);
+        return;
+    }
+#endif
+
+    // the snapshot may already be taken by dfl_cache_key()
+    if (ctx->rom_snapshot && !dfl_rom_snapshot_covers(ctx, first_dfh_addr))
     {
-        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "Truncating parameter DFH Parent Stack size is not allowed");
+        dfl_rom_snapshot_add(ctx, first_dfh_addr, ctx->rom_snapshot_size > 0 ? ctx->rom_snapshot_size : dfl_rom_snapshot_bound(ctx, first_dfh_addr));
     }
+
+    // The DFL is walked once; each interface is appended to the context as it is found.
+    dfl_walk(ctx, first_dfh_addr);
+
+    dfl_rom_snapshot_free(ctx);     // the interface information holds copies of everything it needs, or views into the arena
 }
 
-static int dfh_parent_stack_isempty()
+FPGA_INTERFACE_INDEX common_dfl_scan_ctx_merge(FPGA_DFL_SCAN_CTX *ctx)
 {
-    if (dfh_parent_stack.top == -1)
-        return 1;
-    else
-        return 0;
+    size_t base = common_fpga_interface_info_vec_size();
+
+    if (ctx->num_interfaces > 0)
+    {
+        common_fpga_interface_info_vec_resize(base + ctx->num_interfaces);
+        memcpy(common_fpga_interface_info_vec_at(base), ctx->interfaces, ctx->num_interfaces * sizeof(FPGA_INTERFACE_INFO));
+        for (size_t i = base; i < common_fpga_interface_info_vec_size(); i++)
+        {
+            if (common_fpga_interface_info_vec_at(i)->dfh_parent >= 0)
+            {
+                common_fpga_interface_info_vec_at(i)->dfh_parent += (int)base;
+            }
+            common_fpga_interface_hot_update(i);
+        }
+
+        // the parameters move with their arena chunks
+        common_arena_adopt(&ctx->arena);
+        memset(ctx->interfaces, 0, ctx->num_interfaces * sizeof(FPGA_INTERFACE_INFO));
+        ctx->num_interfaces = 0;
+    }
+
+    return (FPGA_INTERFACE_INDEX)base;
+}
+
+void common_dfl_scan_ctx_cleanup(FPGA_DFL_SCAN_CTX *ctx)
+{
+    dfl_rom_snapshot_free(ctx);
+    free(ctx->interfaces);
+    free(ctx->walk_stack);
+    free(ctx->branches);
+    free(ctx->param_scratch);
+    free(ctx->param_data_scratch);
+    common_arena_release_in(&ctx->arena);
+    memset(ctx, 0, sizeof(FPGA_DFL_SCAN_CTX));
 }
 
-static int dfh_parent_stack_peek()
+/*
+copy the settings of ctx into an empty context walking part of the same DFL
+*/
+static void dfl_scan_ctx_derive(FPGA_DFL_SCAN_CTX *derived, const FPGA_DFL_SCAN_CTX *ctx)
 {
-    return dfh_parent_stack.head[dfh_parent_stack.top];
+    memset(derived, 0, sizeof(FPGA_DFL_SCAN_CTX));
+    derived->range_begin = ctx->range_begin;
+    derived->range_size = ctx->range_size;
+    derived->max_depth = ctx->max_depth;
+    derived->max_interfaces = ctx->max_interfaces;
+    derived->rom_snapshot = ctx->rom_snapshot;
+    derived->rom_snapshot_size = ctx->rom_snapshot_size;
+    derived->param_views = ctx->param_views;
 }
 
-static void dfh_parent_stack_pop()
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+// Branches of the top-level list, shared by the workers of dfl_walk_parallel()
+typedef struct
 {
-    if (!dfh_parent_stack_isempty())
+    const DFL_WALK_ITEM *branches;
+    FPGA_DFL_SCAN_CTX   *branch_ctx;        // One context per branch
+    size_t              num_branches;
+    size_t              next_branch;        // Next branch to walk, claimed with an atomic increment
+} DFL_WALK_POOL;
+
+/*
+walk the top-level list with its branches deferred, then the subtree of each branch in a context of its own on up to
+ctx->num_workers threads, the calling one included, and append the interfaces to ctx in the order of the serial walk
+*/
+static void dfl_walk_parallel(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr)
+{
+    FPGA_DFL_SCAN_CTX top;
+    DFL_WALK_POOL pool;
+    pthread_t *threads = NULL;
+    size_t num_threads = 0;
+
+    dfl_scan_ctx_derive(&top, ctx);
+    top.root_depth = ctx->root_depth;
+    top.root_parent_dfh_address = ctx->root_parent_dfh_address;
+    top.defer_branches = true;
+    common_dfl_scan_ctx_walk(&top, first_dfh_addr);
+
+    pool.branches = top.branches;
+    pool.num_branches = top.num_branches;
+    pool.next_branch = 0;
+    pool.branch_ctx = NULL;
+    if (top.num_branches > 0 && (pool.branch_ctx = (FPGA_DFL_SCAN_CTX *)malloc(top.num_branches * sizeof(FPGA_DFL_SCAN_CTX))) == NULL)
     {
-        dfh_parent_stack.top = dfh_parent_stack.top - 1;
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d DFL scan contexts.", top.num_branches);
+        goto top_cleanup;
     }
-    else
+    for (size_t i = 0; i < top.num_branches; i++)
+    {
+        dfl_scan_ctx_derive(&pool.branch_ctx[i], ctx);
+        pool.branch_ctx[i].root_depth = top.branches[i].depth;
+        pool.branch_ctx[i].root_parent_dfh_address = top.interfaces[top.branches[i].dfh_parent].dfh_address;
+        pool.branch_ctx[i].rom_snapshot_size = top.branches[i].dfl_size;
+    }
+
+    // the calling thread is a worker too, and walks all the branches if no thread can be started
+    if (top.num_branches > 1)
+    {
+        threads = (pthread_t *)malloc((ctx->num_workers - 1) * sizeof(pthread_t));
+    }
+    while (threads != NULL && num_threads + 1 < ctx->num_workers && num_threads + 1 < top.num_branches &&
+           pthread_create(&threads[num_threads], NULL, dfl_walk_worker, &pool) == 0)
+    {
+        num_threads++;
+    }
+    dfl_walk_worker(&pool);
+    for (size_t i = 0; i < num_threads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+
+    // Each top-level interface is followed by the subtrees of its branches.  They were deferred last to first, as the
+    // serial walk pushes them, so they are taken back in reverse.
+    size_t first = ctx->num_interfaces;
+    size_t branch_end = 0;
+    bool is_full = false;
+    for (size_t t = 0; t < top.num_interfaces && !is_full; t++)
+    {
+        size_t branch_begin = branch_end;
+        while (branch_end < top.num_branches && top.branches[branch_end].dfh_parent == (int)t)
+        {
+            branch_end++;
+        }
+
+        is_full = ctx->num_interfaces - first == ctx->max_interfaces;
+        FPGA_INTERFACE_INDEX parent = is_full ? 0 : interface_info_vec_push_back(ctx);
+        if (!is_full)
+        {
+            ctx->interfaces[parent] = top.interfaces[t];
+        }
+        for (size_t b = branch_end; b-- > branch_begin && !is_full;)
+        {
+            FPGA_DFL_SCAN_CTX *branch_ctx = &pool.branch_ctx[b];
+            size_t base = ctx->num_interfaces;
+            for (size_t i = 0; i < branch_ctx->num_interfaces && !is_full; i++)
+            {
+                is_full = ctx->num_interfaces - first == ctx->max_interfaces;
+                if (!is_full)
+                {
+                    FPGA_INTERFACE_INDEX index = interface_info_vec_push_back(ctx);
+                    ctx->interfaces[index] = branch_ctx->interfaces[i];
+                    ctx->interfaces[index].dfh_parent = branch_ctx->interfaces[i].dfh_parent >= 0 ? (int)base + branch_ctx->interfaces[i].dfh_parent : (int)parent;
+                }
+            }
+        }
+    }
+    if (is_full)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "DFL scan stopped at the limit of %d interfaces.", ctx->max_interfaces);
+    }
+    ctx->is_truncated = ctx->is_truncated || is_full || top.is_truncated;
+
+    // the parameters move with their arena chunks
+    for (size_t b = 0; b < top.num_branches; b++)
     {
-        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "Could not retrieve data from DFH Parent Stack, Stack is empty");
+        ctx->is_truncated = ctx->is_truncated || pool.branch_ctx[b].is_truncated;
+        common_arena_move(&ctx->arena, &pool.branch_ctx[b].arena);
+        common_dfl_scan_ctx_cleanup(&pool.branch_ctx[b]);
     }
+    free(pool.branch_ctx);
+    common_arena_move(&ctx->arena, &top.arena);
+
+top_cleanup:
+    common_dfl_scan_ctx_cleanup(&top);
 }
 
-static void dfh_parent_stack_push(int data)
+static void *dfl_walk_worker(void *arg)
 {
-    if (dfh_parent_stack.top == dfh_parent_stack.size)
+    DFL_WALK_POOL *pool = (DFL_WALK_POOL *)arg;
+
+    for (size_t i = __atomic_fetch_add(&pool->next_branch, 1, __ATOMIC_RELAXED); i < pool->num_branches;
+         i = __atomic_fetch_add(&pool->next_branch, 1, __ATOMIC_RELAXED))
     {
-        dfh_parent_stack_resize(dfh_parent_stack.size + DFH_PARENT_STACK_INCR_SIZE);
+        common_dfl_scan_ctx_walk(&pool->branch_ctx[i], pool->branches[i].dfh_addr);
     }
 
-    dfh_parent_stack.top = dfh_parent_stack.top + 1;
-    dfh_parent_stack.head[dfh_parent_stack.top] = data;
+    return NULL;
 }
+#endif
 
-void common_dfl_scan_multi_interfaces(void *first_dfh_addr, FPGA_DFL_BASE_ADDR_DECODER base_addr_decoder)
+/*
+append a zeroed interface to the interfaces of the context and return its index
+the capacity grows geometrically so that a DFL of n interfaces costs O(log n) reallocations
+*/
+static FPGA_INTERFACE_INDEX interface_info_vec_push_back(FPGA_DFL_SCAN_CTX *ctx)
 {
-    s_scanned_interface_count = 0;
-    common_fpga_interface_info_vec_resize(s_scanned_interface_count);
-#ifdef DFL_WALKER_DEBUG_MODE
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Start Scanning Interface...");
-#endif
-    scan_the_num_interfaces(first_dfh_addr);
-    common_fpga_interface_info_vec_resize(s_scanned_interface_count);
-#ifdef DFL_WALKER_DEBUG_MODE
-#endif
-    s_interface_index = -1;
-    dfl_collect_interfaces_info(first_dfh_addr);
+    if (ctx->num_interfaces == ctx->interfaces_reserved)
+    {
+        size_t reserve = ctx->interfaces_reserved > 0 ? 2 * ctx->interfaces_reserved : INTERFACE_INFO_VEC_MIN_RESERVE;
+        FPGA_INTERFACE_INFO *interfaces = (FPGA_INTERFACE_INFO *)realloc(ctx->interfaces, reserve * sizeof(FPGA_INTERFACE_INFO));
+        if (interfaces == NULL)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d interfaces.", reserve);
+            return 0;
+        }
+        memset(interfaces + ctx->interfaces_reserved, 0, (reserve - ctx->interfaces_reserved) * sizeof(FPGA_INTERFACE_INFO));
+        ctx->interfaces = interfaces;
+        ctx->interfaces_reserved = reserve;
+    }
 
-    dfh_parent_stack_resize(0); // free allocated for dfh_parent_stack
+    return (FPGA_INTERFACE_INDEX)ctx->num_interfaces++;
+}
 
-#ifdef DFL_WALKER_REPORT
-    fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "===========================");
-    fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "MMIO Interface(s) registered: %d", common_fpga_interface_info_vec_size());
-    common_dfl_print_all_interfaces(base_addr_decoder);
-#endif
+/*
+read the DFL ROM from the snapshot when the address is covered, otherwise from the device
+*/
+static uint64_t dfl_rom_read_64(FPGA_DFL_SCAN_CTX *ctx, void *begin_address, uint32_t offset)
+{
+    uint8_t *addr = (uint8_t *)begin_address + offset;
+
+    for (size_t i = 0; i < ctx->rom_snapshot_region_count; i++)
+    {
+        DFL_ROM_SNAPSHOT_REGION *region = &ctx->rom_snapshot_regions[i];
+        if (addr >= region->rom && addr + sizeof(uint64_t) <= region->rom + region->size)
+        {
+            uint64_t data;
+            memcpy(&data, region->copy + (addr - region->rom), sizeof(uint64_t));
+            return data;
+        }
+    }
+
+    return common_dfl_read_64(begin_address, offset);
 }
 
-static void scan_the_num_interfaces(void *first_dfh_addr)
+static bool dfl_rom_snapshot_covers(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr)
 {
-    bool collect_interfaces = false;
-    void *current_dfh_addr = first_dfh_addr;
+    uint8_t *addr = (uint8_t *)dfh_addr;
+
+    for (size_t i = 0; i < ctx->rom_snapshot_region_count; i++)
+    {
+        if (addr >= ctx->rom_snapshot_regions[i].rom && addr + DFH_HEADER_SIZE <= ctx->rom_snapshot_regions[i].rom + ctx->rom_snapshot_regions[i].size)
+        {
+            return true;
+        }
+    }
 
-    dfh_parent_stack_push(-1);      // used to track parent dfe
-    deal_with_interface_at_current_level(current_dfh_addr, collect_interfaces);
+    return false;
 }
 
-static void dfl_collect_interfaces_info(void *first_dfh_addr)
+/*
+size of the region spanning from the first to the last DFH of a list, including the header of the last DFH
+only the DFH word of each interface is read; the parameters of the last interface are read from the device
+*/
+static size_t dfl_rom_snapshot_bound(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr)
 {
-    bool collect_interfaces = true;
-    void *current_dfh_addr = first_dfh_addr;
+    uint8_t *dfh_addr = (uint8_t *)first_dfh_addr;
 
-    dfh_parent_stack_push(-1);
-    common_fpga_interface_info_vec_resize(common_fpga_interface_info_vec_size());
-    deal_with_interface_at_current_level(current_dfh_addr, collect_interfaces);
+    for (size_t i = 1; i < ctx->max_interfaces; i++)
+    {
+        uint64_t dfh_start_64_data = common_dfl_read_64(dfh_addr, 0);
+        uint32_t next_dfh_byte_offset = get_next_dfh_byte_offset(dfh_start_64_data);
+
+        if (is_eol(dfh_start_64_data) || next_dfh_byte_offset == 0 || !dfl_in_range(ctx, dfh_addr + next_dfh_byte_offset, DFH_HEADER_SIZE))
+        {
+            break;
+        }
+        dfh_addr += next_dfh_byte_offset;
+    }
+
+    return (size_t)(dfh_addr - (uint8_t *)first_dfh_addr) + DFH_HEADER_SIZE;
 }
 
-static void deal_with_interface_at_current_level(void *current_dfh_addr, bool collect_interfaces)
+/*
+copy size bytes of the DFL ROM from first_dfh_addr into host memory with streaming block reads
+*/
+static void dfl_rom_snapshot_add(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr, size_t size)
 {
-    if (!collect_interfaces)
+    size = (size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+
+    // never copy past the end of the DFL address range
+    if (ctx->range_size > 0)
     {
-        // first walk to get interface count
-        s_scanned_interface_count++;
+        if (!dfl_in_range(ctx, first_dfh_addr, DFH_HEADER_SIZE))
+        {
+            return;
+        }
+        size_t room = (size_t)(ctx->range_begin + ctx->range_size - (uint8_t *)first_dfh_addr) & ~(sizeof(uint64_t) - 1);
+        size = size < room ? size : room;
+    }
+
+    if (ctx->rom_snapshot_region_count == DFL_ROM_SNAPSHOT_MAX_REGIONS)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "DFL ROM snapshot is limited to %d regions; the DFL at 0x%lX is read from the device.", DFL_ROM_SNAPSHOT_MAX_REGIONS, first_dfh_addr);
+        return;
+    }
+
+    uint8_t *copy = (uint8_t *)(ctx->param_views ? common_arena_alloc_in(&ctx->arena, size) : malloc(size));
+    if (copy == NULL)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d bytes of DFL ROM snapshot.", size);
+        return;
+    }
+
+#if defined(FPGA_IP_ACCESS_COMMON_DFL_USE_CUSTOM_MMIO_READ_FUNC) || defined(FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT)
+    for (size_t offset = 0; offset < size; offset += sizeof(uint64_t))
+    {
+        uint64_t data = common_dfl_read_64(first_dfh_addr, offset);
+        memcpy(copy + offset, &data, sizeof(uint64_t));
+    }
+#else
+    if (g_common_dfl_emulate_64bit)
+    {
+        for (size_t offset = 0; offset < size; offset += sizeof(uint64_t))
+        {
+            uint64_t data = common_dfl_read_64(first_dfh_addr, offset);
+            memcpy(copy + offset, &data, sizeof(uint64_t));
+        }
     }
     else
     {
-        // second walk to collect interface infomation into FPGA_INTERFACE_INFO struct
-        s_interface_index++;
-        set_interface_properties(s_interface_index, current_dfh_addr);
+        common_mmio_copy_from_io(copy, first_dfh_addr, size);
     }
+#endif
 
+    ctx->rom_snapshot_regions[ctx->rom_snapshot_region_count].rom = (uint8_t *)first_dfh_addr;
+    ctx->rom_snapshot_regions[ctx->rom_snapshot_region_count].copy = copy;
+    ctx->rom_snapshot_regions[ctx->rom_snapshot_region_count].size = size;
+    ctx->rom_snapshot_region_count++;
 #ifdef DFL_WALKER_DEBUG_MODE
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "--------------------INTERFACE DIVIDER--------------------", current_dfh_addr);
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Current DFL Address: 0x%lX", current_dfh_addr);
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "GUID_L associated with DFH address 0x%lX = 0x%016llX", current_dfh_addr, get_x_feature_guid_l_64(current_dfh_addr));
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "GUID_H associated with DFH address 0x%lX = 0x%016llX", current_dfh_addr, get_x_feature_guid_h_64(current_dfh_addr));
+    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "DFL ROM snapshot of 0x%lX bytes at 0x%lX", size, first_dfh_addr);
 #endif
+}
 
-    // walk through the param list in that interface
-    uint64_t csr_size_group_64_data = get_x_feature_csr_group_size_64_data(current_dfh_addr);
+static void dfl_rom_snapshot_free(FPGA_DFL_SCAN_CTX *ctx)
+{
+    for (size_t i = 0; i < ctx->rom_snapshot_region_count && !ctx->param_views; i++)
+    {
+        free(ctx->rom_snapshot_regions[i].copy);
+    }
+    memset(ctx->rom_snapshot_regions, 0, sizeof(ctx->rom_snapshot_regions));
+    ctx->rom_snapshot_region_count = 0;
+}
 
-#ifdef DFL_WALKER_DEBUG_MODE
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "64-bit csr size group data associated with DFH address 0x%lX = 0x%016llX", current_dfh_addr, csr_size_group_64_data);
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "has_params = %d", has_params(csr_size_group_64_data));
-#endif
+/*
+the copy of size bytes of the DFL ROM at addr when a single snapshot region covers them, NULL otherwise
+*/
+static uint64_t *dfl_rom_snapshot_view(FPGA_DFL_SCAN_CTX *ctx, void *addr, size_t size)
+{
+    uint8_t *begin = (uint8_t *)addr;
 
-    if (has_params(csr_size_group_64_data))
+    for (size_t i = 0; i < ctx->rom_snapshot_region_count; i++)
+    {
+        DFL_ROM_SNAPSHOT_REGION *region = &ctx->rom_snapshot_regions[i];
+        if (begin >= region->rom && begin + size <= region->rom + region->size)
+        {
+            return (uint64_t *)(region->copy + (begin - region->rom));
+        }
+    }
+
+    return NULL;
+}
+
+/*
+validation key of the DFL cache: the settings that change the walker output, and the headers of every DFH the walk
+reaches, branches included, with the parameter headers and branch addresses leading to them.  The parameter data are
+not hashed; a changed subtree, e.g. after a partial reconfiguration, changes the key.  With a ROM snapshot, the key is
+read from the snapshot regions, taken here and reused by the walk; otherwise each hashed word is an MMIO read.
+*/
+static uint64_t dfl_cache_key(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr)
+{
+    uint64_t hash = COMMON_DFL_CACHE_HASH_INIT;
+    int64_t range_offset = ctx->range_size > 0 ? ctx->range_begin - (uint8_t *)first_dfh_addr : 0;
+    size_t num_dfh = 0;
+
+    hash = common_dfl_cache_hash(hash, &g_common_dfl_emulate_64bit, sizeof(g_common_dfl_emulate_64bit));
+    hash = common_dfl_cache_hash(hash, &s_dfl_mmio_access_param_id, sizeof(s_dfl_mmio_access_param_id));
+    hash = common_dfl_cache_hash(hash, &range_offset, sizeof(range_offset));
+    hash = common_dfl_cache_hash(hash, &ctx->range_size, sizeof(ctx->range_size));
+    hash = common_dfl_cache_hash(hash, &ctx->max_depth, sizeof(ctx->max_depth));
+    hash = common_dfl_cache_hash(hash, &ctx->max_interfaces, sizeof(ctx->max_interfaces));
+    hash = common_dfl_cache_hash(hash, &ctx->param_views, sizeof(ctx->param_views));
+
+    if (ctx->rom_snapshot && !dfl_rom_snapshot_covers(ctx, first_dfh_addr))
+    {
+        dfl_rom_snapshot_add(ctx, first_dfh_addr, ctx->rom_snapshot_size > 0 ? ctx->rom_snapshot_size : dfl_rom_snapshot_bound(ctx, first_dfh_addr));
+    }
+
+    // Same traversal bounds as dfl_walk(); a branch looping back is cut by the depth limit.
+    dfl_walk_push(ctx, first_dfh_addr, -1, ctx->root_depth);
+    while (ctx->walk_stack_size > 0 && num_dfh < ctx->max_interfaces)
     {
-        void *current_param_block_addr = get_first_param_header_addr(current_dfh_addr);
+        DFL_WALK_ITEM item = ctx->walk_stack[--ctx->walk_stack_size];
+        uint64_t dfh_start_64_data = 0;
+        uint64_t csr_size_group_64_data = 0;
 
-        // deal with current parameter block address
-        process_param_list_for_known_param_id(current_dfh_addr, current_param_block_addr, collect_interfaces);
+        if (!dfl_in_range(ctx, item.dfh_addr, DFH_HEADER_SIZE))
+        {
+            continue;
+        }
+        num_dfh++;
+
+        for (uint32_t offset = 0; offset < DFH_HEADER_SIZE; offset += sizeof(uint64_t))
+        {
+            uint64_t data = dfl_rom_read_64(ctx, item.dfh_addr, offset);
+            hash = common_dfl_cache_hash(hash, &data, sizeof(data));
+            if (offset == 0)
+            {
+                dfh_start_64_data = data;
+            }
+            csr_size_group_64_data = data;
+        }
+
+        if (!is_eol(dfh_start_64_data) && get_next_dfh_byte_offset(dfh_start_64_data) > 0)
+        {
+            dfl_walk_push(ctx, get_next_dfh_addr(dfh_start_64_data, item.dfh_addr), -1, item.depth);
+        }
+        if (has_params(csr_size_group_64_data))
+        {
+            hash = dfl_cache_key_hash_params(ctx, hash, item.dfh_addr, item.depth);
+        }
     }
+    ctx->walk_stack_size = 0;
 
-    // check current dfh header to see if next dfh exist
-    uint64_t dfh_start_64_data = get_x_feature_dfh_start_64_data(current_dfh_addr);
-#ifdef DFL_WALKER_DEBUG_MODE
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "dfh_start_64_data is 0x%016llX", dfh_start_64_data);
-#endif
+    return hash;
+}
+
+/*
+hash the parameter headers of the DFH at dfh_addr and push the DFLs its branches point to, adding them to the ROM
+snapshot as the walk does
+*/
+static uint64_t dfl_cache_key_hash_params(FPGA_DFL_SCAN_CTX *ctx, uint64_t hash, void *dfh_addr, size_t depth)
+{
+    uint8_t *param_addr = (uint8_t *)get_first_param_header_addr(dfh_addr);
 
-    if (!is_eol(dfh_start_64_data))
+    while (dfl_in_range(ctx, param_addr, PARAM_HEADER_SIZE))
     {
+        uint64_t param_header_64_data = dfl_rom_read_64(ctx, param_addr, 0);
+        uint64_t next_offset = get_next_param_byte_offset(param_header_64_data);
+        size_t param_data_size = is_last_param_block(param_header_64_data) ? next_offset : next_offset - PARAM_HEADER_SIZE;
 
-        // if not the end of the dfh list, get the next dfh address
-        current_dfh_addr = get_next_dfh_addr(dfh_start_64_data, current_dfh_addr);
-#ifdef DFL_WALKER_DEBUG_MODE
-        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Next dfh_addr is 0x%lX", current_dfh_addr);
-#endif
-        // deal with next interface
-        deal_with_interface_at_current_level(current_dfh_addr, collect_interfaces);
+        hash = common_dfl_cache_hash(hash, &param_header_64_data, sizeof(param_header_64_data));
+        if ((is_last_param_block(param_header_64_data) && next_offset == 0) || (!is_last_param_block(param_header_64_data) && next_offset < PARAM_HEADER_SIZE))
+        {
+            break;
+        }
+
+        if (get_param_block_param_id(param_header_64_data) == 0xc && param_data_size >= sizeof(uint64_t) &&
+            dfl_in_range(ctx, param_addr + PARAM_HEADER_SIZE, sizeof(uint64_t)) && depth + 1 <= ctx->max_depth)
+        {
+            uint64_t branch_dfl_64_data = dfl_rom_read_64(ctx, param_addr, PARAM_HEADER_SIZE);
+            void *branch_dfl_addr = get_branch_dfl_addr(branch_dfl_64_data, dfh_addr);
+            hash = common_dfl_cache_hash(hash, &branch_dfl_64_data, sizeof(branch_dfl_64_data));
+            if (ctx->rom_snapshot && dfl_in_range(ctx, branch_dfl_addr, DFH_HEADER_SIZE) && !dfl_rom_snapshot_covers(ctx, branch_dfl_addr))
+            {
+                size_t branch_dfl_size = param_data_size >= 2 * sizeof(uint64_t) && dfl_in_range(ctx, param_addr + PARAM_HEADER_SIZE, 2 * sizeof(uint64_t)) ?
+                                         (uint32_t)dfl_rom_read_64(ctx, param_addr, PARAM_HEADER_SIZE + sizeof(uint64_t)) : 0;
+                dfl_rom_snapshot_add(ctx, branch_dfl_addr, branch_dfl_size > 0 ? branch_dfl_size : dfl_rom_snapshot_bound(ctx, branch_dfl_addr));
+            }
+            dfl_walk_push(ctx, branch_dfl_addr, -1, depth + 1);
+        }
+
+        if (is_last_param_block(param_header_64_data))
+        {
+            break;
+        }
+        param_addr += next_offset;
     }
-    else
+
+    return hash;
+}
+
+/*
+walk the DFL from first_dfh_addr with an explicit stack, within the address range and the scan limits
+*/
+static void dfl_walk(FPGA_DFL_SCAN_CTX *ctx, void *first_dfh_addr)
+{
+    size_t num_interfaces = 0;
+
+    dfl_walk_push(ctx, first_dfh_addr, -1, ctx->root_depth);
+    while (ctx->walk_stack_size > 0)
     {
-        // reached the end of the interface list at current level
-        dfh_parent_stack_pop();
+        DFL_WALK_ITEM item = ctx->walk_stack[--ctx->walk_stack_size];
+
+        if (!dfl_in_range(ctx, item.dfh_addr, DFH_HEADER_SIZE))
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "DFH address 0x%lX is outside of the DFL address range; the rest of its list is ignored.", item.dfh_addr);
+            continue;
+        }
+        if (dfl_walk_is_on_path(ctx, item.dfh_addr, item.dfh_parent))
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "DFH address 0x%lX is reached again through its own branch; the DFL loops back there and the rest of its list is ignored.", item.dfh_addr);
+            continue;
+        }
+        if (num_interfaces == ctx->max_interfaces)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "DFL scan stopped at the limit of %d interfaces.", ctx->max_interfaces);
+            ctx->is_truncated = true;
+            break;
+        }
+        num_interfaces++;
+
+        FPGA_INTERFACE_INDEX index = interface_info_vec_push_back(ctx);
+        set_interface_properties(ctx, index, item.dfh_addr, item.dfh_parent);
+
+#ifdef DFL_WALKER_DEBUG_MODE
+        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "--------------------INTERFACE DIVIDER--------------------", item.dfh_addr);
+        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Current DFL Address: 0x%lX", item.dfh_addr);
+        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "GUID_L associated with DFH address 0x%lX = 0x%016llX", item.dfh_addr, ctx->interfaces[index].guid.guid_l);
+        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "GUID_H associated with DFH address 0x%lX = 0x%016llX", item.dfh_addr, ctx->interfaces[index].guid.guid_h);
+#endif
+
+        // check current dfh header to see if next dfh exist
+        uint64_t dfh_start_64_data = get_x_feature_dfh_start_64_data(ctx, item.dfh_addr);
+#ifdef DFL_WALKER_DEBUG_MODE
+        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "dfh_start_64_data is 0x%016llX", dfh_start_64_data);
+#endif
+        if (ctx->subtree_only && item.dfh_parent < 0)
+        {
+            // the rest of the list is outside of the subtree
+        }
+        else if (!is_eol(dfh_start_64_data) && get_next_dfh_byte_offset(dfh_start_64_data) == 0)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "DFH address 0x%lX is not the end of its list but has no next DFH; the list ends there.", item.dfh_addr);
+        }
+        else if (!is_eol(dfh_start_64_data))
+        {
+            void *next_dfh_addr = get_next_dfh_addr(dfh_start_64_data, item.dfh_addr);
 #ifdef DFL_WALKER_DEBUG_MODE
-        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Reached the end of current level DFL");
+            fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Next dfh_addr is 0x%lX", next_dfh_addr);
 #endif
+            dfl_walk_push(ctx, next_dfh_addr, item.dfh_parent, item.depth);
+        }
+#ifdef DFL_WALKER_DEBUG_MODE
+        else
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Reached the end of current level DFL");
+        }
+#endif
+
+        // the parameters were collected by set_interface_properties(); follow the branches without reading them again
+        process_param_list_for_known_param_id(ctx, index, item.dfh_addr, item.depth);
     }
+    ctx->walk_stack_size = 0;
 }
 
-static uint64_t get_x_feature_dfh_start_64_data(void *current_dfh_address)
+static void dfl_walk_push(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr, int dfh_parent, size_t depth)
+{
+    dfl_walk_items_reserve(&ctx->walk_stack, ctx->walk_stack_size + 1, &ctx->walk_stack_reserved);
+
+    ctx->walk_stack[ctx->walk_stack_size].dfh_addr = dfh_addr;
+    ctx->walk_stack[ctx->walk_stack_size].dfh_parent = dfh_parent;
+    ctx->walk_stack[ctx->walk_stack_size].depth = depth;
+    ctx->walk_stack[ctx->walk_stack_size].dfl_size = 0;
+    ctx->walk_stack_size++;
+}
+
+static void dfl_walk_defer_branch(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr, int dfh_parent, size_t depth, size_t dfl_size)
+{
+    dfl_walk_items_reserve(&ctx->branches, ctx->num_branches + 1, &ctx->branches_reserved);
+
+    ctx->branches[ctx->num_branches].dfh_addr = dfh_addr;
+    ctx->branches[ctx->num_branches].dfh_parent = dfh_parent;
+    ctx->branches[ctx->num_branches].depth = depth;
+    ctx->branches[ctx->num_branches].dfl_size = dfl_size;
+    ctx->num_branches++;
+}
+
+static void dfl_walk_items_reserve(DFL_WALK_ITEM **items, size_t size, size_t *reserved)
+{
+    if (size > *reserved)
+    {
+        size_t reserve = *reserved > 0 ? 2 * *reserved : DFL_WALK_STACK_MIN_RESERVE;
+        DFL_WALK_ITEM *grown = (DFL_WALK_ITEM *)realloc(*items, reserve * sizeof(DFL_WALK_ITEM));
+        if (grown == NULL)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d pending DFH lists.", reserve);
+            return;
+        }
+        *items = grown;
+        *reserved = reserve;
+    }
+}
+
+/*
+true if the DFH is one of the interfaces whose branches lead to it, i.e. following it would loop forever
+a DFL reached through two different branches is not a loop and is walked, and numbered, once per branch
+*/
+static bool dfl_walk_is_on_path(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr, int dfh_parent)
+{
+    for (int i = dfh_parent; i >= 0; i = ctx->interfaces[i].dfh_parent)
+    {
+        if (ctx->interfaces[i].dfh_address == dfh_addr)
+        {
+            return true;
+        }
+    }
+
+    return ctx->root_parent_dfh_address != NULL && ctx->root_parent_dfh_address == dfh_addr;
+}
+
+/*
+true if the size bytes at addr are within the DFL address range, or if no range is set
+*/
+static bool dfl_in_range(FPGA_DFL_SCAN_CTX *ctx, void *addr, size_t size)
+{
+    uint8_t *begin = (uint8_t *)addr;
+
+    return ctx->range_size == 0 ||
+           (begin >= ctx->range_begin && size <= ctx->range_size && (size_t)(begin - ctx->range_begin) <= ctx->range_size - size);
+}
+
+static uint64_t get_x_feature_dfh_start_64_data(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address)
 {
     const uint32_t X_FEATURE_DFH_START_OFFSET = 0x00;
-    uint64_t x_feature_dfh_start_64_data = common_dfl_read_64(current_dfh_address, X_FEATURE_DFH_START_OFFSET);
+    uint64_t x_feature_dfh_start_64_data = dfl_rom_read_64(ctx, current_dfh_address, X_FEATURE_DFH_START_OFFSET);
 
     return x_feature_dfh_start_64_data;
 }
@@ -288,46 +886,44 @@ static void *get_next_dfh_addr(uint64_t dfh_start_64_data, void *current_dfh_add
     return (void *)((char *)current_dfh_address + next_dfh_byte_offset);
 }
 
-static uint64_t get_x_feature_guid_l_64(void *current_dfh_address)
+static uint64_t get_x_feature_guid_l_64(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address)
 {
     const uint32_t X_FEATURE_GUID_L_OFFSET = 0x08;
-    return common_dfl_read_64(current_dfh_address, X_FEATURE_GUID_L_OFFSET);
+    return dfl_rom_read_64(ctx, current_dfh_address, X_FEATURE_GUID_L_OFFSET);
 }
 
-static uint64_t get_x_feature_guid_h_64(void *current_dfh_address)
+static uint64_t get_x_feature_guid_h_64(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address)
 {
     const uint32_t X_FEATURE_GUID_H_OFFSET = 0x10;
-    return common_dfl_read_64(current_dfh_address, X_FEATURE_GUID_H_OFFSET);
+    return dfl_rom_read_64(ctx, current_dfh_address, X_FEATURE_GUID_H_OFFSET);
 }
 
-static FPGA_INTERFACE_GUID get_x_feature_guid_128(void *dfh_addr)
+static FPGA_INTERFACE_GUID get_x_feature_guid_128(FPGA_DFL_SCAN_CTX *ctx, void *dfh_addr)
 {
     FPGA_INTERFACE_GUID guid;
-    guid.guid_h = get_x_feature_guid_h_64(dfh_addr);
-    guid.guid_l = get_x_feature_guid_l_64(dfh_addr);
+    guid.guid_h = get_x_feature_guid_h_64(ctx, dfh_addr);
+    guid.guid_l = get_x_feature_guid_l_64(ctx, dfh_addr);
 
     return guid;
 }
 
 
-static uint64_t get_x_feature_csr_group_size_64_data(void *current_dfh_address)
+static uint64_t get_x_feature_csr_group_size_64_data(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address)
 {
     const uint32_t X_FEATURE_CSR_GROUP_SIZE_OFFSET = 0x20;
-    uint64_t x_feature_csr_group_size_64_data = common_dfl_read_64(current_dfh_address, X_FEATURE_CSR_GROUP_SIZE_OFFSET);
+    uint64_t x_feature_csr_group_size_64_data = dfl_rom_read_64(ctx, current_dfh_address, X_FEATURE_CSR_GROUP_SIZE_OFFSET);
 
     return x_feature_csr_group_size_64_data;
 }
 
-static uint16_t get_instance_id(void *current_dfh_address)
+static uint16_t get_instance_id(uint64_t csr_size_group_64_data)
 {
-    uint64_t x_feature_csr_group_size_64_data = get_x_feature_csr_group_size_64_data(current_dfh_address);
-    return (uint16_t)(x_feature_csr_group_size_64_data & 0x000000000000ffff);
+    return (uint16_t)(csr_size_group_64_data & 0x000000000000ffff);
 }
 
-static uint16_t get_group_id(void *current_dfh_address)
+static uint16_t get_group_id(uint64_t csr_size_group_64_data)
 {
-    uint64_t x_feature_csr_group_size_64_data = get_x_feature_csr_group_size_64_data(current_dfh_address);
-    return (uint16_t)((x_feature_csr_group_size_64_data & 0x000000007fff0000) >> 16);
+    return (uint16_t)((csr_size_group_64_data & 0x000000007fff0000) >> 16);
 }
 
 static void *get_first_param_header_addr(void *dfh_base_addr)
@@ -361,43 +957,10 @@ static uint16_t get_param_block_param_id(uint64_t param_header_64_data)
     return (uint16_t)(param_header_64_data & 0xFFFF);
 }
 
-/*
-resize parameter data under current param_block
-size in number of bytes
-*/
-static void param_data_allocate(FPGA_INTERFACE_INDEX index, FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index, size_t size)
-{
-    if (size % sizeof(uint64_t) != 0)
-    {
-        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "DFH parameter data size, %d, is not multiple of 8.", size);
-    }
-
-    // malloc first param block
-    common_fpga_interface_info_vec_at(index)->parameters[param_block_index].data = (uint64_t *)malloc(size);
-    if (common_fpga_interface_info_vec_at(index)->parameters[param_block_index].data == NULL)
-    {
-        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "Out of memory for parameter data.");
-    }
-    common_fpga_interface_info_vec_at(index)->parameters[param_block_index].data_size = size;
-}
-
-static void param_data_copy(FPGA_INTERFACE_INDEX index, FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index, uint64_t *param_data_addr)
-{
-    size_t param_64_data_count = common_fpga_interface_info_vec_at(index)->parameters[param_block_index].data_size / sizeof(uint64_t);
-    for (int i = 0; i < param_64_data_count; ++i, ++param_data_addr)
-    {
-        uint64_t data = common_dfl_read_64(param_data_addr, 0);
-#ifdef DFL_WALKER_DEBUG_MODE
-        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "parameter block %d data @ index %d (addr: %lX): 0x%016llX", param_block_index, i, param_data_addr, data);
-#endif
-        common_fpga_interface_info_vec_at(index)->parameters[param_block_index].data[i] = data;
-    }
-}
-
-static void *get_base_address(void *current_dfh_address)
+static void *get_base_address(FPGA_DFL_SCAN_CTX *ctx, void *current_dfh_address)
 {
     const uint32_t X_FEATURE_CSR_ADDRESS_OFFSET = 0x18;
-    uint64_t csr_addr = (common_dfl_read_64(current_dfh_address, X_FEATURE_CSR_ADDRESS_OFFSET));
+    uint64_t csr_addr = (dfl_rom_read_64(ctx, current_dfh_address, X_FEATURE_CSR_ADDRESS_OFFSET));
 #ifdef DFL_WALKER_DEBUG_MODE
     fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "CSR address: 0x%llX", csr_addr);
 #endif
@@ -426,57 +989,73 @@ static bool has_params(uint64_t csr_size_group_64_data)
     return (csr_size_group_64_data & 0x0000000080000000) > 0;
 }
 
-static uint32_t get_param_id(uint64_t param_header_64_data)
+/*
+start of the DFL a branch parameter points to: an absolute address, or a signed offset from the DFH owning the branch
+*/
+static void *get_branch_dfl_addr(uint64_t branch_dfl_64_data, void *current_dfh_addr)
 {
-    return (param_header_64_data & 0x000000000000FFFF);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+    if (branch_dfl_64_data & 0b1)
+    {
+        return (void *)(branch_dfl_64_data & 0xFFFFFFFFFFFFFFF8);
+    }
+
+    return (void *)((int64_t)current_dfh_addr + (int64_t)(branch_dfl_64_data & 0xFFFFFFFFFFFFFFF8));
+#pragma GCC diagnostic pop
 }
 
-static void handle_branch_param_id(void *current_dfh_addr, void *current_param_block_addr, bool collect_interfaces)
+static void handle_branch_param_id(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *current_dfh_addr, FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index, size_t depth)
 {
-    const uint32_t PARAM_DATA_OFFSET = 0x8;
+    FPGA_INTERFACE_PARAMETER *param = &ctx->interfaces[index].parameters[param_block_index];
+
+    if (param->data_size < sizeof(uint64_t))
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "Branch parameter of the interface at DFH address 0x%lX has no data; ignored.", current_dfh_addr);
+        return;
+    }
 
-    dfh_parent_stack_push(s_interface_index);
-    // valid branch data
-    uint64_t branch_dfl_64_data = common_dfl_read_64(current_param_block_addr, PARAM_DATA_OFFSET);
+    if (depth + 1 > ctx->max_depth)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "Branch of the interface at DFH address 0x%lX exceeds the limit of %d DFL levels; ignored.", current_dfh_addr, ctx->max_depth);
+        ctx->is_truncated = true;
+        return;
+    }
+
+    // valid branch data, the first 64-bit word of the parameter data
+    uint64_t branch_dfl_64_data = param->data[0];
 #ifdef DFL_WALKER_DEBUG_MODE
-    const uint32_t BRANCH_DFL_SIZE_OFFSET = 0x10;
-    uint32_t branch_dfl_size = common_dfl_read_32(current_param_block_addr, BRANCH_DFL_SIZE_OFFSET); // not used right now
     fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "branch_dfl_64_data: 0x%016llX", branch_dfl_64_data);
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "branch_dfl_size: 0x%X", branch_dfl_size);
 #endif
-    // check branch address: relative or absolute
-    bool is_absolute = branch_dfl_64_data & 0b1;
-    void *next_level_dfl_start_address;
-    if (is_absolute)
-    {
-        // branch to next level dfl using absolute address
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
-#pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
-        next_level_dfl_start_address = (void *)(branch_dfl_64_data & 0xFFFFFFFFFFFFFFF8);
+    void *next_level_dfl_start_address = get_branch_dfl_addr(branch_dfl_64_data, current_dfh_addr);
 #ifdef DFL_WALKER_DEBUG_MODE
-        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "next_level_dfl_start_address: 0x%lX", next_level_dfl_start_address);
+    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "next_level_dfl_start_address: 0x%lX", next_level_dfl_start_address);
 #endif
-    }
-    else
-    {
-        // branch to next level dfl using relative address (signed offset from dfh start)
-        next_level_dfl_start_address = (void *)((int64_t)current_dfh_addr + (int64_t)(branch_dfl_64_data & 0xFFFFFFFFFFFFFFF8));
-#pragma GCC diagnostic pop
-        // branch to next level dfl
+    size_t branch_dfl_size = param->data_size >= 2 * sizeof(uint64_t) ? (uint32_t)param->data[1] : 0;
 #ifdef DFL_WALKER_DEBUG_MODE
-        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "next_level_dfl_start_address: 0x%lX", next_level_dfl_start_address);
+    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "branch_dfl_size: 0x%X", branch_dfl_size);
 #endif
+    if (ctx->defer_branches)
+    {
+        // walked later by a context of its own, which takes its own ROM snapshot
+        dfl_walk_defer_branch(ctx, next_level_dfl_start_address, index, depth + 1, branch_dfl_size);
+        return;
+    }
+    if (ctx->rom_snapshot && dfl_in_range(ctx, next_level_dfl_start_address, DFH_HEADER_SIZE) && !dfl_rom_snapshot_covers(ctx, next_level_dfl_start_address))
+    {
+        dfl_rom_snapshot_add(ctx, next_level_dfl_start_address, branch_dfl_size > 0 ? branch_dfl_size : dfl_rom_snapshot_bound(ctx, next_level_dfl_start_address));
     }
-    deal_with_interface_at_current_level(next_level_dfl_start_address, collect_interfaces);
+    dfl_walk_push(ctx, next_level_dfl_start_address, index, depth + 1);
 }
 
-static void handle_well_known_param_id(void *current_dfh_addr, void *current_param_block_addr, int param_id, bool collect_interfaces)
+static void handle_well_known_param_id(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *current_dfh_addr, FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index, size_t depth)
 {
-    
+    uint16_t param_id = ctx->interfaces[index].parameters[param_block_index].param_id;
+
     if (param_id == 0xc)
     {
-        handle_branch_param_id(current_dfh_addr, current_param_block_addr, collect_interfaces);
+        handle_branch_param_id(ctx, index, current_dfh_addr, param_block_index, depth);
     }
     else
     {
@@ -484,110 +1063,158 @@ static void handle_well_known_param_id(void *current_dfh_addr, void *current_par
     }
 }
 
-static void process_param_list_for_known_param_id(void *current_dfh_addr, void *current_param_block_addr, bool collect_interfaces)
+static void process_param_list_for_known_param_id(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *current_dfh_addr, size_t depth)
 {
 #ifdef DFL_WALKER_DEBUG_MODE
     fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "----------PARAMETER BLOCK DIVIDER----------", current_dfh_addr);
     fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Scanning Parameter Under DFH address 0x%lX", current_dfh_addr);
 #endif
 
-    FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index = 0;
-
-    void *next_param_block_addr;
-    uint32_t param_id;
-    uint64_t param_header_64_data = common_dfl_read_64(current_param_block_addr, 0);
-
-    // parameter list is terminated by a NULL parameter block with eop == 1 and no parameter data
-    while (!is_last_param_block(param_header_64_data) || get_next_param_byte_offset(param_header_64_data) > 0)
+    // The branches are pushed last to first so that they are popped, and walked, in their DFL order.
+    for (FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index = ctx->interfaces[index].num_of_parameters; param_block_index-- > 0;)
     {
-        param_id = get_param_id(param_header_64_data);
-
 #ifdef DFL_WALKER_DEBUG_MODE
-        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "param_header_64_data at address 0x%lX = 0x%016llX", current_param_block_addr, param_header_64_data);
-        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "param_id: 0x%lX", param_id);
+        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "param_id: 0x%lX", ctx->interfaces[index].parameters[param_block_index].param_id);
 #endif
-
         // based on parameter ID, decide branch or do other stuff
-        handle_well_known_param_id(current_dfh_addr, current_param_block_addr, param_id, collect_interfaces);
+        handle_well_known_param_id(ctx, index, current_dfh_addr, param_block_index, depth);
+    }
+}
 
-        // If this is last param block, don't advance to read next param block.
-        if (!is_last_param_block(param_header_64_data))
+/*
+grow the parameter scratch to size parameter blocks; the new blocks are zeroed
+*/
+static void param_scratch_resize(FPGA_DFL_SCAN_CTX *ctx, size_t size)
+{
+    if (size > ctx->param_scratch_reserved)
+    {
+        size_t reserve = ctx->param_scratch_reserved > 0 ? ctx->param_scratch_reserved : PARAM_SCRATCH_MIN_RESERVE;
+        while (reserve < size)
         {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
-#pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
-            next_param_block_addr = (void *)((uint64_t)current_param_block_addr + get_next_param_byte_offset(param_header_64_data));
-#pragma GCC diagnostic pop
+            reserve *= 2;
+        }
+        FPGA_INTERFACE_PARAMETER *scratch = (FPGA_INTERFACE_PARAMETER *)realloc(ctx->param_scratch, reserve * sizeof(FPGA_INTERFACE_PARAMETER));
+        if (scratch == NULL)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d parameter blocks.", size);
+            return;
+        }
+        ctx->param_scratch = scratch;
+        ctx->param_scratch_reserved = reserve;
+    }
+    if (size > ctx->param_scratch_count)
+    {
+        memset(ctx->param_scratch + ctx->param_scratch_count, 0, (size - ctx->param_scratch_count) * sizeof(FPGA_INTERFACE_PARAMETER));
+    }
+    ctx->param_scratch_count = size;
+}
 
-#ifdef DFL_WALKER_DEBUG_MODE
-            fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "current_param_block_addr: 0x%lX", current_param_block_addr);
-            fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "next_param_block_offset in bytes: 0x%lX", next_param_block_addr);
-#endif
+/*
+copy the parameter data at param_data_addr behind the data already in the scratch
+size in number of bytes
+*/
+static void param_data_scratch_append(FPGA_DFL_SCAN_CTX *ctx, void *param_data_addr, size_t size)
+{
+    if (size % sizeof(uint64_t) != 0)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "DFH parameter data size, %d, is not multiple of 8.", size);
+        return;
+    }
 
-            // check next param block
-            param_header_64_data = common_dfl_read_64(next_param_block_addr, 0);
-            current_param_block_addr = next_param_block_addr;
-            param_block_index++;
+    size_t param_64_data_count = size / sizeof(uint64_t);
+    if (ctx->param_data_scratch_used + param_64_data_count > ctx->param_data_scratch_reserved)
+    {
+        size_t reserve = ctx->param_data_scratch_reserved > 0 ? ctx->param_data_scratch_reserved : PARAM_SCRATCH_MIN_RESERVE;
+        while (reserve < ctx->param_data_scratch_used + param_64_data_count)
+        {
+            reserve *= 2;
         }
-        else
+        uint64_t *scratch = (uint64_t *)realloc(ctx->param_data_scratch, reserve * sizeof(uint64_t));
+        if (scratch == NULL)
         {
-            break;
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "Out of memory for parameter data.");
+            return;
         }
+        ctx->param_data_scratch = scratch;
+        ctx->param_data_scratch_reserved = reserve;
     }
 
+    uint64_t *param_data = (uint64_t *)param_data_addr;
+    for (int i = 0; i < param_64_data_count; ++i, ++param_data)
+    {
+        uint64_t data = dfl_rom_read_64(ctx, param_data, 0);
 #ifdef DFL_WALKER_DEBUG_MODE
-    fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "reached NULL parameter block at address: 0x%lX", current_param_block_addr);
+        fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "parameter block %d data @ index %d (addr: %lX): 0x%016llX", ctx->param_scratch_count - 1, i, param_data, data);
 #endif
-
+        ctx->param_data_scratch[ctx->param_data_scratch_used++] = data;
+    }
 }
 
 /*
-initlaize the parameter block under current interface, should only be called once per interface
+move the parameter blocks collected in the scratch to the arena: the parameter array of the interface is followed
+by the data of all its parameter blocks in a single allocation; the blocks viewing the ROM snapshot keep their data
 */
-static void param_block_init(FPGA_INTERFACE_INDEX index)
+static void param_scratch_commit(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index)
 {
-    // malloc first param block
-    common_fpga_interface_info_vec_at(index)->parameters = (FPGA_INTERFACE_PARAMETER *)malloc(sizeof(FPGA_INTERFACE_PARAMETER));
-    if (common_fpga_interface_info_vec_at(index)->parameters == NULL)
+    size_t param_size = ctx->param_scratch_count * sizeof(FPGA_INTERFACE_PARAMETER);
+    size_t data_size = ctx->param_data_scratch_used * sizeof(uint64_t);
+    FPGA_INTERFACE_PARAMETER *parameters = (FPGA_INTERFACE_PARAMETER *)common_arena_alloc_in(&ctx->arena, param_size + data_size);
+    if (parameters == NULL)
     {
-        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for first interfaces.");
+        // the interface is kept without its parameters
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d bytes of parameters.", param_size + data_size);
+        ctx->param_scratch_count = 0;
+        ctx->param_data_scratch_used = 0;
+        return;
+    }
+    uint64_t *data = (uint64_t *)((uint8_t *)parameters + param_size);
+
+    memcpy(parameters, ctx->param_scratch, param_size);
+    memcpy(data, ctx->param_data_scratch, data_size);
+    for (size_t i = 0; i < ctx->param_scratch_count; i++)
+    {
+        if (parameters[i].data == NULL)
+        {
+            parameters[i].data = parameters[i].data_size > 0 ? data : NULL;
+            data += parameters[i].data_size / sizeof(uint64_t);
+        }
     }
-    common_fpga_interface_info_vec_at(index)->num_of_parameters = 1;
+
+    ctx->interfaces[index].parameters = parameters;
+    ctx->interfaces[index].num_of_parameters = ctx->param_scratch_count;
+    ctx->param_scratch_count = 0;
+    ctx->param_data_scratch_used = 0;
+    common_dfl_param_order_build(&ctx->interfaces[index], &ctx->arena);
 }
 
 /*
-resize parameter block under current interface
-size in number of parameter blocks
+sort the parameter positions of the interface by param_id, highest version first; equal blocks keep their DFL order
 */
-static void param_block_resize(FPGA_INTERFACE_INDEX index, size_t size)
+void common_dfl_param_order_build(FPGA_INTERFACE_INFO *info, COMMON_ARENA *arena)
 {
-    if (size > common_fpga_interface_info_vec_at(index)->num_of_parameters)
+    size_t size = info->num_of_parameters * sizeof(uint32_t);
+    uint32_t *order = (uint32_t *)(arena != NULL ? common_arena_alloc_in(arena, size) : common_arena_alloc(size));
+    if (order == NULL)
     {
-        common_fpga_interface_info_vec_at(index)->parameters = realloc(common_fpga_interface_info_vec_at(index)->parameters, size * sizeof(FPGA_INTERFACE_PARAMETER));
-        if (common_fpga_interface_info_vec_at(index)->parameters == NULL)
-        {
-            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d parameter blocks.", size);
-        }
-        else
-        {
-            memset(common_fpga_interface_info_vec_at(index)->parameters + common_fpga_interface_info_vec_at(index)->num_of_parameters, 0, 
-            (size - common_fpga_interface_info_vec_at(index)->num_of_parameters) * sizeof(FPGA_INTERFACE_PARAMETER));
-            common_fpga_interface_info_vec_at(index)->num_of_parameters = size;
-        }
+        // fpga_get_parameter() falls back to a linear search
+        info->param_order = NULL;
+        return;
     }
-    else if (size == 0)
+
+    // insertion sort; an interface has a handful of parameters
+    for (uint32_t i = 0; i < info->num_of_parameters; i++)
     {
-        if (common_fpga_interface_info_vec_at(index)->parameters != NULL)
+        const FPGA_INTERFACE_PARAMETER *param = &info->parameters[i];
+        uint32_t j = i;
+        while (j > 0 && (info->parameters[order[j - 1]].param_id > param->param_id ||
+                         (info->parameters[order[j - 1]].param_id == param->param_id && info->parameters[order[j - 1]].version < param->version)))
         {
-            free(common_fpga_interface_info_vec_at(index)->parameters);
+            order[j] = order[j - 1];
+            j--;
         }
-        common_fpga_interface_info_vec_at(index)->parameters = NULL;
-        common_fpga_interface_info_vec_at(index)->num_of_parameters = 0;
-    }
-    else if (size < common_fpga_interface_info_vec_at(index)->num_of_parameters)
-    {
-        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "truncating parameter block size is not allowed");
+        order[j] = i;
     }
+    info->param_order = order;
 }
 
 /*
@@ -595,87 +1222,130 @@ add parameter block information under current interface
 index: interface index number
 dfh_addr: current interface dfh_address
 */
-static void set_parameter_properties(FPGA_INTERFACE_INDEX index, void *dfh_addr)
+static void set_parameter_properties(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *dfh_addr, uint64_t csr_size_group_64_data)
 {
-    uint64_t csr_size_group_64_data = get_x_feature_csr_group_size_64_data(dfh_addr);
-
     if (has_params(csr_size_group_64_data))
     {
         FPGA_INTERFACE_PARAM_BLOCK_INDEX param_block_index = 0;
-
         size_t param_data_size;
         void *next_param_block_addr;
         void *current_param_block_addr = get_first_param_header_addr(dfh_addr);
-        uint64_t param_header_64_data = common_dfl_read_64(current_param_block_addr, 0);
+        if (!dfl_in_range(ctx, current_param_block_addr, PARAM_HEADER_SIZE))
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "Parameters of the interface at DFH address 0x%lX are outside of the DFL address range; ignored.", dfh_addr);
+            return;
+        }
+        uint64_t param_header_64_data = dfl_rom_read_64(ctx, current_param_block_addr, 0);
 
         // parameter list is terminated by a NULL parameter block with eop == 1 and no parameter data
         while (!is_last_param_block(param_header_64_data) || get_next_param_byte_offset(param_header_64_data) > 0)
         {
+            if (is_last_param_block(param_header_64_data))
+            {
+                param_data_size = get_next_param_byte_offset(param_header_64_data); // If EOP bit is set, the size is the byte offset.
+            }
+            else if (get_next_param_byte_offset(param_header_64_data) >= PARAM_HEADER_SIZE)
+            {
+                param_data_size = get_next_param_byte_offset(param_header_64_data) - PARAM_HEADER_SIZE;
+            }
+            else
+            {
+                fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "Parameter block at 0x%lX has no room for its header; the rest of the parameters are ignored.", current_param_block_addr);
+                break;
+            }
+            if (!dfl_in_range(ctx, current_param_block_addr, PARAM_HEADER_SIZE + param_data_size))
+            {
+                fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "Parameter block at 0x%lX ends outside of the DFL address range; the rest of the parameters are ignored.", current_param_block_addr);
+                break;
+            }
+
             if ( param_block_index == 0)
             {
-                param_block_init(index);
+                param_scratch_resize(ctx, 1);
             }
-            common_fpga_interface_info_vec_at(index)->parameters[param_block_index].version = get_param_block_version(param_header_64_data);
-            common_fpga_interface_info_vec_at(index)->parameters[param_block_index].param_id = get_param_block_param_id(param_header_64_data);
+            ctx->param_scratch[param_block_index].version = get_param_block_version(param_header_64_data);
+            ctx->param_scratch[param_block_index].param_id = get_param_block_param_id(param_header_64_data);
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
 #pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
 
 #ifdef DFL_WALKER_DEBUG_MODE
-            common_fpga_interface_info_vec_at(index)->parameters[param_block_index].current_param_addr = (uint64_t)current_param_block_addr;
+            ctx->param_scratch[param_block_index].current_param_addr = (uint64_t)current_param_block_addr;
 #endif
-            if (is_last_param_block(param_header_64_data))
-            {
-                param_data_size = get_next_param_byte_offset(param_header_64_data); // If EOP bit is set, the size is the byte offset.
-            }
-            else
+            void *param_data_start_addr = (void *)((uint64_t)current_param_block_addr + PARAM_HEADER_SIZE);
+            ctx->param_scratch[param_block_index].data = ctx->param_views && param_data_size > 0 && param_data_size % sizeof(uint64_t) == 0 ? dfl_rom_snapshot_view(ctx, param_data_start_addr, param_data_size) : NULL;
+            if (ctx->param_scratch[param_block_index].data == NULL)
             {
-                param_data_size = get_next_param_byte_offset(param_header_64_data) - PARAM_HEADER_SIZE;            
+                param_data_scratch_append(ctx, param_data_start_addr, param_data_size);
             }
-            param_data_allocate(index, param_block_index, param_data_size);
-            void *param_data_start_addr = (void *)((uint64_t)current_param_block_addr + PARAM_HEADER_SIZE);
-            param_data_copy(index, param_block_index, param_data_start_addr);
+            ctx->param_scratch[param_block_index].data_size = param_data_size;
 
             // If this is last param block, don't advance to read next param block.
             if (!is_last_param_block(param_header_64_data))
             {
                 next_param_block_addr = (void *)((uint64_t)current_param_block_addr + get_next_param_byte_offset(param_header_64_data));
 #ifdef DFL_WALKER_DEBUG_MODE
-                common_fpga_interface_info_vec_at(index)->parameters[param_block_index].next_param_addr = (uint64_t)next_param_block_addr;
+                ctx->param_scratch[param_block_index].next_param_addr = (uint64_t)next_param_block_addr;
 #endif
 #pragma GCC diagnostic pop
+                if (!dfl_in_range(ctx, next_param_block_addr, PARAM_HEADER_SIZE))
+                {
+                    fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "Parameter block at 0x%lX is outside of the DFL address range; the rest of the parameters are ignored.", next_param_block_addr);
+                    break;
+                }
                 // check next param block
-                param_header_64_data = common_dfl_read_64(next_param_block_addr, 0);
+                param_header_64_data = dfl_rom_read_64(ctx, next_param_block_addr, 0);
                 current_param_block_addr = next_param_block_addr;
                 param_block_index++;
-                param_block_resize(index, (param_block_index + 1));
+                param_scratch_resize(ctx, param_block_index + 1);
             }
             else
             {
 #ifdef DFL_WALKER_DEBUG_MODE
-                common_fpga_interface_info_vec_at(index)->parameters[param_block_index].next_param_addr = 0;
+                ctx->param_scratch[param_block_index].next_param_addr = 0;
 #endif
                 break;
             }
         }
+
+        if (ctx->param_scratch_count > 0)
+        {
+            param_scratch_commit(ctx, index);
+        }
     }
 }
 
-static void set_interface_properties(FPGA_INTERFACE_INDEX index, void *dfh_addr)
+static void set_interface_properties(FPGA_DFL_SCAN_CTX *ctx, FPGA_INTERFACE_INDEX index, void *dfh_addr, int dfh_parent)
 {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
-    common_fpga_interface_info_vec_at(index)->base_address = (void *)((char *)get_base_address(dfh_addr));
+    ctx->interfaces[index].base_address = (void *)((char *)get_base_address(ctx, dfh_addr));
 #pragma GCC diagnostic pop
-    common_fpga_interface_info_vec_at(index)->dfl = true;
-    common_fpga_interface_info_vec_at(index)->guid = get_x_feature_guid_128(dfh_addr);
-    common_fpga_interface_info_vec_at(index)->instance_id = get_instance_id(dfh_addr);
-    common_fpga_interface_info_vec_at(index)->group_id = get_group_id(dfh_addr);
-    common_fpga_interface_info_vec_at(index)->dfh_parent = dfh_parent_stack_peek();
-    common_fpga_interface_info_vec_at(index)->is_mmio_opened = false;
-    common_fpga_interface_info_vec_at(index)->is_interrupt_opened = false;
-    set_parameter_properties(index, dfh_addr);
+    ctx->interfaces[index].dfl = true;
+    ctx->interfaces[index].dfh_address = dfh_addr;
+    ctx->interfaces[index].guid = get_x_feature_guid_128(ctx, dfh_addr);
+    uint64_t csr_size_group_64_data = get_x_feature_csr_group_size_64_data(ctx, dfh_addr);   // read once for all its fields
+    ctx->interfaces[index].instance_id = get_instance_id(csr_size_group_64_data);
+    ctx->interfaces[index].group_id = get_group_id(csr_size_group_64_data);
+    ctx->interfaces[index].dfh_parent = dfh_parent;
+    ctx->interfaces[index].is_mmio_opened = false;
+    ctx->interfaces[index].is_interrupt_opened = false;
+    set_parameter_properties(ctx, index, dfh_addr, csr_size_group_64_data);
+    ctx->interfaces[index].emulate_64bit = get_64bit_emulation(&ctx->interfaces[index]);
+}
+
+static bool get_64bit_emulation(const FPGA_INTERFACE_INFO *info)
+{
+    for (size_t i = 0; s_dfl_mmio_access_param_id != 0 && i < info->num_of_parameters; i++)
+    {
+        if (info->parameters[i].param_id == s_dfl_mmio_access_param_id && info->parameters[i].data_size >= sizeof(uint64_t))
+        {
+            return (info->parameters[i].data[0] & DFL_PARAM_MMIO_ACCESS_EMULATE_64BIT) != 0;
+        }
+    }
+
+    return g_common_dfl_emulate_64bit;
 }
 
 void common_dfl_print_all_interfaces(FPGA_DFL_BASE_ADDR_DECODER base_addr_decoder)
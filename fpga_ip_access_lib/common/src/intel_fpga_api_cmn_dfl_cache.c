@@ -0,0 +1,185 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "intel_fpga_api_cmn_dfl.h"
+#include "intel_fpga_api_cmn_dfl_cache.h"
+#include "intel_fpga_api_cmn_dfl_export.h"
+#include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_inf.h"
+#include "intel_fpga_api_cmn_arena.h"
+
+#define DFL_CACHE_MAGIC             0x434c464441475046ULL   // "FPGADFLC"
+
+// The cache file is the image of fpga_dfl_export() with the addresses relative to the entry DFH and the validation key
+// in its header.
+static bool dfl_cache_parse(const uint8_t *image, size_t size, void *first_dfh_addr, uint64_t key);
+
+bool common_dfl_cache_load(const char *path, void *first_dfh_addr, uint64_t key)
+{
+    bool ret = false;
+    struct stat st;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(DFL_EXPORT_HEADER))
+    {
+        void *image = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (image != MAP_FAILED)
+        {
+            ret = dfl_cache_parse((const uint8_t *)image, st.st_size, first_dfh_addr, key);
+            munmap(image, st.st_size);
+        }
+    }
+    close(fd);
+
+    return ret;
+}
+
+bool common_dfl_cache_save(const char *path, void *first_dfh_addr, uint64_t key)
+{
+    bool ret = common_dfl_export_save(path, DFL_CACHE_MAGIC, key, DFL_EXPORT_ADDR_RELATIVE, first_dfh_addr);
+    if (!ret)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "Cannot write the DFL cache file %s.", path);
+    }
+
+    return ret;
+}
+
+static bool dfl_cache_parse(const uint8_t *image, size_t size, void *first_dfh_addr, uint64_t key)
+{
+    const DFL_EXPORT_HEADER *header = (const DFL_EXPORT_HEADER *)image;
+    const uint8_t *p = image + sizeof(DFL_EXPORT_HEADER);
+    const uint8_t *end = image + size;
+
+    if (header->magic != DFL_CACHE_MAGIC || header->version != DFL_EXPORT_VERSION || header->key != key || header->size != size ||
+        header->checksum != common_dfl_cache_hash(COMMON_DFL_CACHE_HASH_INIT, p, size - sizeof(DFL_EXPORT_HEADER)))
+    {
+        return false;
+    }
+
+    common_fpga_interface_info_vec_resize(header->num_of_interfaces);
+    for (size_t i = 0; i < header->num_of_interfaces; i++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+        const DFL_EXPORT_INTERFACE *record = (const DFL_EXPORT_INTERFACE *)p;
+
+        if ((size_t)(end - p) < sizeof(DFL_EXPORT_INTERFACE))
+        {
+            goto err_format;
+        }
+        p += sizeof(DFL_EXPORT_INTERFACE);
+
+        info->guid.guid_l = record->guid_l;
+        info->guid.guid_h = record->guid_h;
+        info->dfh_address = (uint8_t *)first_dfh_addr + (int64_t)record->dfh_address;
+        if (record->flags & DFL_EXPORT_ABSOLUTE_BASE)
+        {
+            info->base_address = (void *)(uintptr_t)record->base_address;
+        }
+        else
+        {
+            info->base_address = (uint8_t *)first_dfh_addr + (int64_t)record->base_address;
+        }
+        info->dfl = (record->flags & DFL_EXPORT_DFL) != 0;
+        info->dfh_parent = record->dfh_parent;
+        info->instance_id = record->instance_id;
+        info->group_id = record->group_id;
+        info->emulate_64bit = (record->flags & DFL_EXPORT_EMULATE_64BIT) != 0;
+        info->is_mmio_opened = false;
+        info->is_interrupt_opened = false;
+        common_fpga_interface_hot_update(i);
+
+        // The parameter records are validated and measured first so that the parameter array and all its data
+        // can be placed in one arena allocation.
+        const uint8_t *q = p;
+        size_t data_size = 0;
+        for (size_t j = 0; j < record->num_of_parameters; j++)
+        {
+            const DFL_EXPORT_PARAMETER *param = (const DFL_EXPORT_PARAMETER *)q;
+
+            if ((size_t)(end - q) < sizeof(DFL_EXPORT_PARAMETER) || (size_t)(end - q) - sizeof(DFL_EXPORT_PARAMETER) < param->data_size ||
+                param->data_size % sizeof(uint64_t) != 0)
+            {
+                goto err_format;
+            }
+            q += sizeof(DFL_EXPORT_PARAMETER) + param->data_size;
+            data_size += param->data_size;
+        }
+
+        if (record->num_of_parameters > 0)
+        {
+            size_t param_size = record->num_of_parameters * sizeof(FPGA_INTERFACE_PARAMETER);
+            info->parameters = (FPGA_INTERFACE_PARAMETER *)common_arena_alloc(param_size + data_size);
+            if (info->parameters == NULL)
+            {
+                goto err_format;
+            }
+            info->num_of_parameters = record->num_of_parameters;
+
+            uint64_t *data = (uint64_t *)((uint8_t *)info->parameters + param_size);
+            for (size_t j = 0; j < info->num_of_parameters; j++)
+            {
+                const DFL_EXPORT_PARAMETER *param = (const DFL_EXPORT_PARAMETER *)p;
+                p += sizeof(DFL_EXPORT_PARAMETER);
+
+                info->parameters[j].version = param->version;
+                info->parameters[j].param_id = param->param_id;
+                info->parameters[j].data = param->data_size > 0 ? data : NULL;
+                info->parameters[j].data_size = param->data_size;
+                memcpy(data, p, param->data_size);
+                data += param->data_size / sizeof(uint64_t);
+                p += param->data_size;
+            }
+            common_dfl_param_order_build(info, NULL);
+        }
+    }
+
+    if (p == end)
+    {
+        return true;
+    }
+
+err_format:
+    common_fpga_interface_info_vec_resize(0);
+    return false;
+}
+
+#endif // ZEPHYR_FPGA_IP_ACCESS
@@ -0,0 +1,282 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <unistd.h>
+
+#include "intel_fpga_api_cmn_dfl.h"
+#include "intel_fpga_api_cmn_dfl_cache.h"
+#include "intel_fpga_api_cmn_dfl_export.h"
+#include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_inf.h"
+
+#define DFL_EXPORT_CSR_ADDR_OFFSET  0x18
+
+typedef struct
+{
+    const uint8_t *image;
+    size_t size;
+} DFL_EXPORT_IMAGE;
+
+static size_t dfl_export_image_size();
+static void dfl_export_build_image(uint8_t *image, size_t size, uint64_t magic, uint64_t key, DFL_EXPORT_ADDR_ENCODING encoding, void *first_dfh_addr);
+static bool dfl_export_write_file(const char *path, bool (*write_content)(FILE *file, const void *context), const void *context);
+static bool dfl_export_write_image(FILE *file, const void *context);
+static bool dfl_export_write_json(FILE *file, const void *context);
+static uint32_t dfl_export_flags(const FPGA_INTERFACE_INFO *info);
+
+int fpga_dfl_export(const char *path, FPGA_DFL_EXPORT_FORMAT format)
+{
+    bool ret;
+
+    if (path == NULL || (format != FPGA_DFL_EXPORT_BINARY && format != FPGA_DFL_EXPORT_JSON))
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "DFL export needs a path and a format.");
+        return -1;
+    }
+
+    if (format == FPGA_DFL_EXPORT_BINARY)
+    {
+        ret = common_dfl_export_save(path, DFL_EXPORT_MAGIC, 0, DFL_EXPORT_ADDR_DECODED, NULL);
+    }
+    else
+    {
+        ret = dfl_export_write_file(path, dfl_export_write_json, NULL);
+    }
+    if (!ret)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Cannot write the DFL export file %s.", path);
+    }
+
+    return ret ? 0 : -1;
+}
+
+bool common_dfl_export_save(const char *path, uint64_t magic, uint64_t key, DFL_EXPORT_ADDR_ENCODING encoding, void *first_dfh_addr)
+{
+    DFL_EXPORT_IMAGE export_image;
+    size_t size = dfl_export_image_size();
+    uint8_t *image = (uint8_t *)calloc(1, size);
+    bool ret;
+
+    if (image == NULL)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d bytes of DFL image.", size);
+        return false;
+    }
+    dfl_export_build_image(image, size, magic, key, encoding, first_dfh_addr);
+
+    export_image.image = image;
+    export_image.size = size;
+    ret = dfl_export_write_file(path, dfl_export_write_image, &export_image);
+    free(image);
+
+    return ret;
+}
+
+/*
+write a temporary file and rename it so that a concurrent reader never sees a partial file
+*/
+static bool dfl_export_write_file(const char *path, bool (*write_content)(FILE *file, const void *context), const void *context)
+{
+    bool ret = false;
+    FILE *file;
+    int fd;
+    char *tmp_path = (char *)malloc(strlen(path) + sizeof(".XXXXXX"));
+
+    if (tmp_path == NULL)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for the path %s.", path);
+        return false;
+    }
+
+    strcpy(tmp_path, path);
+    strcat(tmp_path, ".XXXXXX");
+    fd = mkstemp(tmp_path);
+    if (fd < 0)
+    {
+        goto err_open;
+    }
+    file = fdopen(fd, "w");
+    if (file == NULL)
+    {
+        close(fd);
+        unlink(tmp_path);
+        goto err_open;
+    }
+    ret = write_content(file, context);
+    ret = fclose(file) == 0 && ret;
+    if (ret)
+    {
+        ret = rename(tmp_path, path) == 0;
+    }
+    if (!ret)
+    {
+        unlink(tmp_path);
+    }
+
+err_open:
+    free(tmp_path);
+
+    return ret;
+}
+
+static bool dfl_export_write_image(FILE *file, const void *context)
+{
+    const DFL_EXPORT_IMAGE *export_image = (const DFL_EXPORT_IMAGE *)context;
+
+    return fwrite(export_image->image, 1, export_image->size, file) == export_image->size;
+}
+
+static uint32_t dfl_export_flags(const FPGA_INTERFACE_INFO *info)
+{
+    return (info->is_removed ? DFL_EXPORT_REMOVED : 0) | (info->emulate_64bit ? DFL_EXPORT_EMULATE_64BIT : 0) | (info->dfl ? DFL_EXPORT_DFL : 0);
+}
+
+static size_t dfl_export_image_size()
+{
+    size_t size = sizeof(DFL_EXPORT_HEADER);
+
+    for (size_t i = 0; i < common_fpga_interface_info_vec_size(); i++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+
+        size += sizeof(DFL_EXPORT_INTERFACE);
+        for (size_t j = 0; j < info->num_of_parameters; j++)
+        {
+            size += sizeof(DFL_EXPORT_PARAMETER) + info->parameters[j].data_size;
+        }
+    }
+
+    return size;
+}
+
+static void dfl_export_build_image(uint8_t *image, size_t size, uint64_t magic, uint64_t key, DFL_EXPORT_ADDR_ENCODING encoding, void *first_dfh_addr)
+{
+    DFL_EXPORT_HEADER *header = (DFL_EXPORT_HEADER *)image;
+    uint8_t *p = image + sizeof(DFL_EXPORT_HEADER);
+
+    for (size_t i = 0; i < common_fpga_interface_info_vec_size(); i++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+        DFL_EXPORT_INTERFACE *record = (DFL_EXPORT_INTERFACE *)p;
+
+        record->guid_l = info->guid.guid_l;
+        record->guid_h = info->guid.guid_h;
+        record->flags = dfl_export_flags(info);
+        if (encoding == DFL_EXPORT_ADDR_RELATIVE)
+        {
+            record->dfh_address = (uint64_t)((uint8_t *)info->dfh_address - (uint8_t *)first_dfh_addr);
+            // The walker resolved the CSR address already; its type is read back from the DFH to store it position-independent.
+            if (info->dfl && (common_dfl_read_64(info->dfh_address, DFL_EXPORT_CSR_ADDR_OFFSET) & 0b1))
+            {
+                record->flags |= DFL_EXPORT_ABSOLUTE_BASE;
+                record->base_address = (uint64_t)(uintptr_t)info->base_address;
+            }
+            else
+            {
+                record->base_address = (uint64_t)((uint8_t *)info->base_address - (uint8_t *)first_dfh_addr);
+            }
+        }
+        else
+        {
+            record->dfh_address = info->dfl ? common_dfl_decode_base_address(info->dfh_address) : 0;
+            record->base_address = common_dfl_decode_base_address(info->base_address);
+        }
+        record->dfh_parent = info->dfh_parent;
+        record->instance_id = info->instance_id;
+        record->group_id = info->group_id;
+        record->num_of_parameters = info->num_of_parameters;
+        p += sizeof(DFL_EXPORT_INTERFACE);
+
+        for (size_t j = 0; j < info->num_of_parameters; j++)
+        {
+            DFL_EXPORT_PARAMETER *param = (DFL_EXPORT_PARAMETER *)p;
+
+            param->version = info->parameters[j].version;
+            param->param_id = info->parameters[j].param_id;
+            param->data_size = info->parameters[j].data_size;
+            p += sizeof(DFL_EXPORT_PARAMETER);
+            memcpy(p, info->parameters[j].data, info->parameters[j].data_size);
+            p += info->parameters[j].data_size;
+        }
+    }
+
+    header->magic = magic;
+    header->version = DFL_EXPORT_VERSION;
+    header->num_of_interfaces = common_fpga_interface_info_vec_size();
+    header->key = key;
+    header->size = size;
+    header->checksum = common_dfl_cache_hash(COMMON_DFL_CACHE_HASH_INIT, image + sizeof(DFL_EXPORT_HEADER), size - sizeof(DFL_EXPORT_HEADER));
+}
+
+/*
+one object per interface in index order; the numbers that are addresses, GUIDs or data are hexadecimal strings, since
+JSON numbers do not hold 64 bits reliably
+*/
+static bool dfl_export_write_json(FILE *file, const void *context)
+{
+    (void)context;
+
+    fprintf(file, "{\n  \"version\": %d,\n  \"interfaces\": [", DFL_EXPORT_VERSION);
+    for (size_t i = 0; i < common_fpga_interface_info_vec_size(); i++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+
+        fprintf(file, "%s\n    {\n", i > 0 ? "," : "");
+        fprintf(file, "      \"index\": %zu,\n", i);
+        fprintf(file, "      \"guid\": \"%016" PRIx64 "%016" PRIx64 "\",\n", info->guid.guid_h, info->guid.guid_l);
+        fprintf(file, "      \"instance_id\": %u,\n", info->instance_id);
+        fprintf(file, "      \"group_id\": %u,\n", info->group_id);
+        fprintf(file, "      \"parent\": %d,\n", info->dfh_parent);
+        fprintf(file, "      \"base_address\": \"0x%" PRIx64 "\",\n", common_dfl_decode_base_address(info->base_address));
+        fprintf(file, "      \"dfl\": %s,\n", info->dfl ? "true" : "false");
+        fprintf(file, "      \"emulate_64bit\": %s,\n", info->emulate_64bit ? "true" : "false");
+        fprintf(file, "      \"removed\": %s,\n", info->is_removed ? "true" : "false");
+        fprintf(file, "      \"parameters\": [");
+        for (size_t j = 0; j < info->num_of_parameters; j++)
+        {
+            const FPGA_INTERFACE_PARAMETER *param = &info->parameters[j];
+
+            fprintf(file, "%s\n        { \"param_id\": %u, \"version\": %u, \"data\": [", j > 0 ? "," : "", param->param_id, param->version);
+            for (size_t k = 0; k < param->data_size / sizeof(uint64_t); k++)
+            {
+                fprintf(file, "%s\"0x%016" PRIx64 "\"", k > 0 ? ", " : "", param->data[k]);
+            }
+            fprintf(file, "] }");
+        }
+        fprintf(file, "%s]\n    }", info->num_of_parameters > 0 ? "\n      " : "");
+    }
+    fprintf(file, "%s]\n}\n", common_fpga_interface_info_vec_size() > 0 ? "\n  " : "");
+
+    return ferror(file) == 0;
+}
+
+#endif // ZEPHYR_FPGA_IP_ACCESS
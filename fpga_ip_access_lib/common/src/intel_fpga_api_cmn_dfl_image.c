@@ -0,0 +1,214 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "intel_fpga_api_cmn_dfl.h"
+#include "intel_fpga_api_cmn_dfl_image.h"
+#include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_inf.h"
+
+#define DFL_IMAGE_TEXT_HEADER   "Dumping DFL ROM Content..."
+#define DFL_IMAGE_TEXT_LINE_MAX 256
+
+static DFL_IMAGE_FORMAT dfl_image_detect_format(FILE *file);
+static uint8_t *dfl_image_map_raw(FILE *file, size_t *size);
+static uint8_t *dfl_image_map_text(FILE *file, size_t *size);
+static bool dfl_image_parse_text_line(const char *line, uint64_t *address, uint64_t *data);
+
+static uint8_t *s_dfl_image = NULL;
+static size_t s_dfl_image_size = 0;
+static uint64_t s_dfl_image_base_address = 0;
+
+int common_dfl_image_scan(const char *path, DFL_IMAGE_FORMAT format, uint64_t base_address)
+{
+    FILE *file;
+    uint8_t *image;
+    size_t size = 0;
+
+    common_dfl_image_unload();
+
+    if (path == NULL)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "DFL image needs a path.");
+        return -1;
+    }
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Cannot open the DFL image file %s.", path);
+        return -1;
+    }
+    if (format == DFL_IMAGE_AUTO)
+    {
+        format = dfl_image_detect_format(file);
+    }
+    image = format == DFL_IMAGE_TEXT ? dfl_image_map_text(file, &size) : dfl_image_map_raw(file, &size);
+    fclose(file);
+    if (image == NULL)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Cannot load the DFL image file %s.", path);
+        return -1;
+    }
+
+    s_dfl_image = image;
+    s_dfl_image_size = size;
+    s_dfl_image_base_address = base_address;
+
+    common_dfl_set_address_range(image, size);
+    common_dfl_scan_multi_interfaces(image, common_dfl_image_base_addr_decoder);
+
+    // Each interface may be accessed up to the end of the image; interfaces decoded outside of it get no span.
+    for (size_t i = 0; i < common_fpga_interface_info_vec_size(); i++)
+    {
+        uint8_t *base = (uint8_t *)common_fpga_interface_info_vec_at(i)->base_address;
+
+        common_fpga_interface_info_vec_at(i)->address_span = (base >= image && base < image + size) ? (size_t)(image + size - base) : 0;
+    }
+
+    return (int)common_fpga_interface_info_vec_size();
+}
+
+void common_dfl_image_unload()
+{
+    if (s_dfl_image == NULL)
+    {
+        return;
+    }
+
+    // The interface table points into the image
+    common_fpga_interface_info_vec_resize(0);
+    common_dfl_set_address_range(NULL, 0);
+    common_dfl_set_base_addr_decoder(NULL);
+
+    munmap(s_dfl_image, s_dfl_image_size);
+    s_dfl_image = NULL;
+    s_dfl_image_size = 0;
+    s_dfl_image_base_address = 0;
+}
+
+uint64_t common_dfl_image_base_addr_decoder(uint64_t base_addr)
+{
+    return base_addr - (uint64_t)(uintptr_t)s_dfl_image + s_dfl_image_base_address;
+}
+
+static DFL_IMAGE_FORMAT dfl_image_detect_format(FILE *file)
+{
+    char head[sizeof(DFL_IMAGE_TEXT_HEADER)] = { 0 };
+    size_t count = fread(head, 1, sizeof(head) - 1, file);
+
+    rewind(file);
+    if (strcmp(head, DFL_IMAGE_TEXT_HEADER) == 0 || (count >= 2 && head[0] == '0' && head[1] == 'x'))
+    {
+        return DFL_IMAGE_TEXT;
+    }
+    return DFL_IMAGE_RAW;
+}
+
+static uint8_t *dfl_image_map_raw(FILE *file, size_t *size)
+{
+    struct stat st;
+    void *image;
+
+    if (fstat(fileno(file), &st) != 0 || st.st_size < (off_t)sizeof(uint64_t))
+    {
+        return NULL;
+    }
+
+    // A private mapping, so that writes to the interfaces never reach the file
+    image = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(file), 0);
+    if (image == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    *size = (size_t)st.st_size;
+    return (uint8_t *)image;
+}
+
+// The dump holds one 64-bit word per line, with the address it was read from.  The image spans from the lowest to the
+// highest address; words missing from the dump read as 0.
+static uint8_t *dfl_image_map_text(FILE *file, size_t *size)
+{
+    char line[DFL_IMAGE_TEXT_LINE_MAX];
+    uint64_t address;
+    uint64_t data;
+    uint64_t first = UINT64_MAX;
+    uint64_t last = 0;
+    void *image;
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (dfl_image_parse_text_line(line, &address, &data))
+        {
+            first = address < first ? address : first;
+            last = address > last ? address : last;
+        }
+    }
+    if (first > last || (last - first) >= SIZE_MAX - sizeof(uint64_t))
+    {
+        return NULL;
+    }
+
+    *size = (size_t)(last - first) + sizeof(uint64_t);
+    image = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (image == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    rewind(file);
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (!dfl_image_parse_text_line(line, &address, &data))
+        {
+            continue;
+        }
+        if (((address - first) & 0x7) != 0)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "DFL image word at address 0x%" PRIX64 " is not 64-bit aligned to the image; ignored.", address);
+            continue;
+        }
+        ((uint64_t *)image)[(address - first) / sizeof(uint64_t)] = data;
+    }
+
+    return (uint8_t *)image;
+}
+
+static bool dfl_image_parse_text_line(const char *line, uint64_t *address, uint64_t *data)
+{
+    return sscanf(line, "0x%" SCNx64 " 64 bit data is: 0x%" SCNx64, address, data) == 2;
+}
+
+#endif // ZEPHYR_FPGA_IP_ACCESS
@@ -0,0 +1,234 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intel_fpga_api_cmn_dfl.h"
+#include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_inf.h"
+#include "intel_fpga_api_cmn_arena.h"
+#include "intel_fpga_api_cmn_index.h"
+
+static bool dfl_rescan_is_in_subtree(size_t index, size_t root);
+static size_t dfl_rescan_depth(size_t index);
+static bool dfl_rescan_is_changed(const FPGA_INTERFACE_INFO *info, const FPGA_INTERFACE_INFO *found, int dfh_parent);
+
+/*
+re-walk the DFH of the interface at parent_index and its branches, then fold the result into the interface table:
+- an interface found again at the same DFH address keeps its index, and is updated in place when it differs
+- an interface not found any more is marked removed; its index is not reused
+- a new interface is appended, so that the indices of all the other interfaces stay valid
+the caller keeps the other threads, the interrupt thread of the platform included, off the table; see fpga_dfl_rescan()
+*/
+int fpga_dfl_rescan(unsigned int parent_index, FPGA_DFL_RESCAN_CALLBACK callback, void *context)
+{
+    int ret = -1;
+    size_t size = common_fpga_interface_info_vec_size();
+    size_t *old_index = NULL;                   // Interfaces of the subtree in the table, in ascending index order
+    bool *is_matched = NULL;
+    FPGA_INTERFACE_INDEX *new_index = NULL;     // Table index of each interface of the walk
+    size_t num_old = 0;
+    size_t num_added = 0;
+    bool is_adopted = false;                    // Otherwise the walk is freed with the context
+    FPGA_DFL_SCAN_CTX ctx;
+
+    if (parent_index >= size || common_fpga_interface_info_vec_at(parent_index)->dfh_address == NULL ||
+        common_fpga_interface_info_vec_at(parent_index)->is_removed)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Interface %u is not a DFL interface; it cannot be rescanned.", parent_index);
+        return -1;
+    }
+
+    common_dfl_scan_ctx_init(&ctx);
+    ctx.num_workers = 0;
+    ctx.subtree_only = true;
+    ctx.root_depth = dfl_rescan_depth(parent_index);
+    if (common_fpga_interface_info_vec_at(parent_index)->dfh_parent >= 0)
+    {
+        ctx.root_parent_dfh_address = common_fpga_interface_info_vec_at(common_fpga_interface_info_vec_at(parent_index)->dfh_parent)->dfh_address;
+    }
+    common_dfl_scan_ctx_walk(&ctx, common_fpga_interface_info_vec_at(parent_index)->dfh_address);
+    if (ctx.num_interfaces == 0)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "DFH of interface %u cannot be walked; the interface table is left unchanged.", parent_index);
+        goto ctx_cleanup;
+    }
+
+    old_index = (size_t *)malloc(size * sizeof(size_t));
+    is_matched = (bool *)calloc(size, sizeof(bool));
+    new_index = (FPGA_INTERFACE_INDEX *)malloc(ctx.num_interfaces * sizeof(FPGA_INTERFACE_INDEX));
+    if (old_index == NULL || is_matched == NULL || new_index == NULL)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory to rescan %ld interfaces.", ctx.num_interfaces);
+        goto ctx_cleanup;
+    }
+    for (size_t i = parent_index; i < size; i++)
+    {
+        if (!common_fpga_interface_info_vec_at(i)->is_removed && dfl_rescan_is_in_subtree(i, parent_index))
+        {
+            old_index[num_old++] = i;
+        }
+    }
+
+    // A DFL reached through two branches appears once per branch, so the interfaces are paired by DFH address in
+    // walk order.  The walk starts at the DFH of parent_index, which always pairs with it.
+    for (size_t k = 0; k < ctx.num_interfaces; k++)
+    {
+        size_t m = 0;
+        while (m < num_old && (is_matched[m] || common_fpga_interface_info_vec_at(old_index[m])->dfh_address != ctx.interfaces[k].dfh_address))
+        {
+            m++;
+        }
+        if (m < num_old)
+        {
+            is_matched[m] = true;
+            new_index[k] = (FPGA_INTERFACE_INDEX)old_index[m];
+        }
+        else
+        {
+            new_index[k] = (FPGA_INTERFACE_INDEX)(size + num_added++);
+        }
+    }
+    if (num_added > 0)
+    {
+        common_fpga_interface_info_vec_resize(size + num_added);
+    }
+
+    ret = 0;
+    for (size_t k = 0; k < ctx.num_interfaces; k++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(new_index[k]);
+        const FPGA_INTERFACE_INFO *found = &ctx.interfaces[k];
+        int dfh_parent = found->dfh_parent >= 0 ? (int)new_index[found->dfh_parent] : info->dfh_parent;
+
+        if (new_index[k] >= size)
+        {
+            *info = *found;
+            info->dfh_parent = k > 0 ? dfh_parent : common_fpga_interface_info_vec_at(parent_index)->dfh_parent;
+        }
+        else if (dfl_rescan_is_changed(info, found, dfh_parent))
+        {
+            // the DFL describes the interface; the open state, the ISR, the lock and the shadow belong to the user
+            info->guid = found->guid;
+            info->instance_id = found->instance_id;
+            info->group_id = found->group_id;
+            info->num_of_parameters = found->num_of_parameters;
+            info->parameters = found->parameters;
+            info->param_order = found->param_order;
+            info->base_address = found->base_address;
+            info->emulate_64bit = found->emulate_64bit;
+            info->dfh_parent = dfh_parent;
+        }
+        else
+        {
+            continue;
+        }
+        if (!is_adopted)
+        {
+            common_arena_adopt(&ctx.arena);     // the parameters of the walk now belong to the table
+            is_adopted = true;
+        }
+        common_fpga_interface_hot_update(new_index[k]);     // an open handle follows the new base address
+        ret++;
+        if (callback != NULL)
+        {
+            callback(new_index[k] >= size ? FPGA_DFL_RESCAN_ADDED : FPGA_DFL_RESCAN_CHANGED, new_index[k], context);
+        }
+    }
+    for (size_t m = 0; m < num_old; m++)
+    {
+        if (!is_matched[m])
+        {
+            common_fpga_interface_info_vec_at(old_index[m])->is_removed = true;
+            ret++;
+            if (callback != NULL)
+            {
+                callback(FPGA_DFL_RESCAN_REMOVED, old_index[m], context);
+            }
+        }
+    }
+    common_index_build();
+
+ctx_cleanup:
+    free(old_index);
+    free(is_matched);
+    free(new_index);
+    common_dfl_scan_ctx_cleanup(&ctx);
+
+    return ret;
+}
+
+static bool dfl_rescan_is_in_subtree(size_t index, size_t root)
+{
+    for (int i = (int)index; i >= 0; i = common_fpga_interface_info_vec_at(i)->dfh_parent)
+    {
+        if ((size_t)i == root)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static size_t dfl_rescan_depth(size_t index)
+{
+    size_t depth = 0;
+
+    for (int i = common_fpga_interface_info_vec_at(index)->dfh_parent; i >= 0; i = common_fpga_interface_info_vec_at(i)->dfh_parent)
+    {
+        depth++;
+    }
+
+    return depth;
+}
+
+static bool dfl_rescan_is_changed(const FPGA_INTERFACE_INFO *info, const FPGA_INTERFACE_INFO *found, int dfh_parent)
+{
+    if (info->guid.guid_l != found->guid.guid_l || info->guid.guid_h != found->guid.guid_h ||
+        info->instance_id != found->instance_id || info->group_id != found->group_id ||
+        info->base_address != found->base_address || info->dfh_parent != dfh_parent ||
+        info->num_of_parameters != found->num_of_parameters)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < info->num_of_parameters; i++)
+    {
+        const FPGA_INTERFACE_PARAMETER *param = &info->parameters[i];
+        const FPGA_INTERFACE_PARAMETER *found_param = &found->parameters[i];
+        if (param->param_id != found_param->param_id || param->version != found_param->version || param->data_size != found_param->data_size ||
+            (param->data_size > 0 && memcmp(param->data, found_param->data, param->data_size) != 0))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
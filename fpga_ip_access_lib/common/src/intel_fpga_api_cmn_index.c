@@ -0,0 +1,389 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_inf.h"
+#include "intel_fpga_api_cmn_index.h"
+
+#define COMMON_INDEX_EMPTY_SLOT (-1)
+
+// Open addressing table from GUID to the lowest interface index with that GUID.  Interfaces sharing a GUID are chained
+// in ascending index order through s_common_index_next, so that a lookup by GUID and instance ID, or of all instances
+// of a GUID, touches the matching interfaces only.
+static int32_t *s_common_index_slots = NULL;
+static int32_t *s_common_index_next = NULL;
+static size_t s_common_index_mask = 0;
+static size_t s_common_index_size = 0;      // Number of interfaces covered by the index
+
+// The same for the group IDs, in a table of the same capacity sharing the allocation
+static int32_t *s_common_index_group_slots = NULL;
+static int32_t *s_common_index_group_next = NULL;
+
+// Interface tree as first-child and next-sibling links from dfh_parent, children in ascending index order.  The
+// top-level interfaces are the children of s_common_index_first_top.
+static int32_t *s_common_index_first_child = NULL;
+static int32_t *s_common_index_next_sibling = NULL;
+static int32_t s_common_index_first_top = COMMON_INDEX_EMPTY_SLOT;
+
+static size_t common_index_hash(const FPGA_INTERFACE_GUID *guid);
+static bool common_index_guid_equal(const FPGA_INTERFACE_GUID *guid, size_t index);
+static int32_t common_index_lookup(const FPGA_INTERFACE_GUID *guid);
+static bool common_index_group_equal(uint16_t group_id, size_t index);
+static int32_t common_index_group_lookup(uint16_t group_id);
+static size_t common_index_covered();
+static int32_t common_index_first_child(int32_t parent);
+static int32_t common_index_next_sibling(int32_t index);
+
+static size_t common_index_hash(const FPGA_INTERFACE_GUID *guid)
+{
+    uint64_t h = guid->guid_l ^ (guid->guid_h * 0x9E3779B97F4A7C15ULL);
+    h ^= h >> 32;
+    h *= 0xD6E8FEB86659FD93ULL;
+    h ^= h >> 32;
+    return (size_t)h;
+}
+
+static bool common_index_guid_equal(const FPGA_INTERFACE_GUID *guid, size_t index)
+{
+    const FPGA_INTERFACE_GUID *other = &common_fpga_interface_info_vec_at(index)->guid;
+    return other->guid_l == guid->guid_l && other->guid_h == guid->guid_h && !common_fpga_interface_info_vec_at(index)->is_removed;
+}
+
+/*
+return the lowest indexed interface with the GUID, or COMMON_INDEX_EMPTY_SLOT
+*/
+static int32_t common_index_lookup(const FPGA_INTERFACE_GUID *guid)
+{
+    for (size_t slot = common_index_hash(guid) & s_common_index_mask; s_common_index_slots[slot] != COMMON_INDEX_EMPTY_SLOT; slot = (slot + 1) & s_common_index_mask)
+    {
+        if (common_index_guid_equal(guid, s_common_index_slots[slot]))
+        {
+            return s_common_index_slots[slot];
+        }
+    }
+    return COMMON_INDEX_EMPTY_SLOT;
+}
+
+static bool common_index_group_equal(uint16_t group_id, size_t index)
+{
+    return common_fpga_interface_info_vec_at(index)->group_id == group_id && !common_fpga_interface_info_vec_at(index)->is_removed;
+}
+
+/*
+return the lowest indexed interface with the group ID, or COMMON_INDEX_EMPTY_SLOT
+*/
+static int32_t common_index_group_lookup(uint16_t group_id)
+{
+    for (size_t slot = (group_id * 0x9E3779B1U) & s_common_index_mask; s_common_index_group_slots[slot] != COMMON_INDEX_EMPTY_SLOT; slot = (slot + 1) & s_common_index_mask)
+    {
+        if (common_index_group_equal(group_id, s_common_index_group_slots[slot]))
+        {
+            return s_common_index_group_slots[slot];
+        }
+    }
+    return COMMON_INDEX_EMPTY_SLOT;
+}
+
+/*
+number of interfaces the index can answer for; the interfaces behind them are searched linearly
+*/
+static size_t common_index_covered()
+{
+    return s_common_index_size <= common_fpga_interface_info_vec_size() ? s_common_index_size : 0;
+}
+
+void common_index_build()
+{
+    size_t size = common_fpga_interface_info_vec_size();
+    size_t capacity = 8;
+
+    common_index_clear();
+    if (size == 0)
+    {
+        return;
+    }
+
+    // keep the load factor at or below 1/2
+    while (capacity < 2 * size)
+    {
+        capacity *= 2;
+    }
+    s_common_index_slots = (int32_t *)malloc((2 * capacity + 4 * size) * sizeof(int32_t));
+    if (s_common_index_slots == NULL)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for the index of %d interfaces.", size);
+        return;
+    }
+    memset(s_common_index_slots, 0xFF, (2 * capacity + 4 * size) * sizeof(int32_t));    // COMMON_INDEX_EMPTY_SLOT
+    s_common_index_next = s_common_index_slots + capacity;
+    s_common_index_group_slots = s_common_index_next + size;
+    s_common_index_group_next = s_common_index_group_slots + capacity;
+    s_common_index_first_child = s_common_index_group_next + size;
+    s_common_index_next_sibling = s_common_index_first_child + size;
+    s_common_index_mask = capacity - 1;
+
+    // Inserting from the highest index down leaves each chain in ascending index order.  Removed interfaces are left out.
+    for (size_t i = size; i-- > 0;)
+    {
+        if (common_fpga_interface_info_vec_at(i)->is_removed)
+        {
+            continue;
+        }
+        const FPGA_INTERFACE_GUID *guid = &common_fpga_interface_info_vec_at(i)->guid;
+        size_t slot = common_index_hash(guid) & s_common_index_mask;
+
+        while (s_common_index_slots[slot] != COMMON_INDEX_EMPTY_SLOT && !common_index_guid_equal(guid, s_common_index_slots[slot]))
+        {
+            slot = (slot + 1) & s_common_index_mask;
+        }
+        s_common_index_next[i] = s_common_index_slots[slot];
+        s_common_index_slots[slot] = (int32_t)i;
+
+        uint16_t group_id = common_fpga_interface_info_vec_at(i)->group_id;
+        for (slot = (group_id * 0x9E3779B1U) & s_common_index_mask;
+             s_common_index_group_slots[slot] != COMMON_INDEX_EMPTY_SLOT && !common_index_group_equal(group_id, s_common_index_group_slots[slot]);
+             slot = (slot + 1) & s_common_index_mask)
+        {
+        }
+        s_common_index_group_next[i] = s_common_index_group_slots[slot];
+        s_common_index_group_slots[slot] = (int32_t)i;
+
+        int parent = common_fpga_interface_info_vec_at(i)->dfh_parent;
+        int32_t *first = parent >= 0 && (size_t)parent < size ? &s_common_index_first_child[parent] : &s_common_index_first_top;
+        s_common_index_next_sibling[i] = *first;
+        *first = (int32_t)i;
+    }
+    s_common_index_size = size;
+}
+
+void common_index_clear()
+{
+    free(s_common_index_slots);
+    s_common_index_slots = NULL;
+    s_common_index_next = NULL;
+    s_common_index_group_slots = NULL;
+    s_common_index_group_next = NULL;
+    s_common_index_first_child = NULL;
+    s_common_index_next_sibling = NULL;
+    s_common_index_first_top = COMMON_INDEX_EMPTY_SLOT;
+    s_common_index_mask = 0;
+    s_common_index_size = 0;
+}
+
+int fpga_find_interface(const FPGA_INTERFACE_GUID *guid, uint16_t instance_id)
+{
+    if (guid == NULL)
+    {
+        return -1;
+    }
+
+    size_t covered = common_index_covered();
+    if (covered > 0)
+    {
+        for (int32_t i = common_index_lookup(guid); i != COMMON_INDEX_EMPTY_SLOT; i = s_common_index_next[i])
+        {
+            if (common_fpga_interface_info_vec_at(i)->instance_id == instance_id)
+            {
+                return i;
+            }
+        }
+    }
+    for (size_t i = covered; i < common_fpga_interface_info_vec_size(); i++)
+    {
+        if (common_index_guid_equal(guid, i) && common_fpga_interface_info_vec_at(i)->instance_id == instance_id)
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+unsigned int fpga_find_all_by_guid(const FPGA_INTERFACE_GUID *guid, unsigned int *indices, unsigned int max_indices)
+{
+    unsigned int count = 0;
+
+    if (guid == NULL)
+    {
+        return 0;
+    }
+
+    size_t covered = common_index_covered();
+    if (covered > 0)
+    {
+        for (int32_t i = common_index_lookup(guid); i != COMMON_INDEX_EMPTY_SLOT; i = s_common_index_next[i])
+        {
+            if (indices != NULL && count < max_indices)
+            {
+                indices[count] = (unsigned int)i;
+            }
+            count++;
+        }
+    }
+    for (size_t i = covered; i < common_fpga_interface_info_vec_size(); i++)
+    {
+        if (common_index_guid_equal(guid, i))
+        {
+            if (indices != NULL && count < max_indices)
+            {
+                indices[count] = (unsigned int)i;
+            }
+            count++;
+        }
+    }
+
+    return count;
+}
+
+unsigned int fpga_get_group_members(uint16_t group_id, unsigned int *indices, unsigned int max_indices)
+{
+    unsigned int count = 0;
+    size_t covered = common_index_covered();
+
+    if (covered > 0)
+    {
+        for (int32_t i = common_index_group_lookup(group_id); i != COMMON_INDEX_EMPTY_SLOT; i = s_common_index_group_next[i])
+        {
+            if (indices != NULL && count < max_indices)
+            {
+                indices[count] = (unsigned int)i;
+            }
+            count++;
+        }
+    }
+    for (size_t i = covered; i < common_fpga_interface_info_vec_size(); i++)
+    {
+        if (common_index_group_equal(group_id, i))
+        {
+            if (indices != NULL && count < max_indices)
+            {
+                indices[count] = (unsigned int)i;
+            }
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*
+the lowest indexed child of parent, or of the top level when parent is -1; COMMON_INDEX_EMPTY_SLOT if there is none
+*/
+static int32_t common_index_first_child(int32_t parent)
+{
+    size_t covered = common_index_covered();
+
+    if (covered > 0)
+    {
+        int32_t first = parent >= 0 ? ((size_t)parent < covered ? s_common_index_first_child[parent] : COMMON_INDEX_EMPTY_SLOT) : s_common_index_first_top;
+        if (first != COMMON_INDEX_EMPTY_SLOT)
+        {
+            return first;
+        }
+    }
+    for (size_t i = covered > (size_t)(parent + 1) ? covered : (size_t)(parent + 1); i < common_fpga_interface_info_vec_size(); i++)
+    {
+        if (common_fpga_interface_info_vec_at(i)->dfh_parent == parent && !common_fpga_interface_info_vec_at(i)->is_removed)
+        {
+            return (int32_t)i;
+        }
+    }
+
+    return COMMON_INDEX_EMPTY_SLOT;
+}
+
+/*
+the next higher indexed interface with the same parent, or COMMON_INDEX_EMPTY_SLOT if there is none
+*/
+static int32_t common_index_next_sibling(int32_t index)
+{
+    size_t covered = common_index_covered();
+    int parent = common_fpga_interface_info_vec_at(index)->dfh_parent;
+
+    if ((size_t)index < covered && s_common_index_next_sibling[index] != COMMON_INDEX_EMPTY_SLOT)
+    {
+        return s_common_index_next_sibling[index];
+    }
+    for (size_t i = covered > (size_t)(index + 1) ? covered : (size_t)(index + 1); i < common_fpga_interface_info_vec_size(); i++)
+    {
+        if (common_fpga_interface_info_vec_at(i)->dfh_parent == parent && !common_fpga_interface_info_vec_at(i)->is_removed)
+        {
+            return (int32_t)i;
+        }
+    }
+
+    return COMMON_INDEX_EMPTY_SLOT;
+}
+
+unsigned int fpga_get_children(unsigned int index, unsigned int *indices, unsigned int max_indices)
+{
+    unsigned int count = 0;
+
+    if (index >= common_fpga_interface_info_vec_size() || common_fpga_interface_info_vec_at(index)->is_removed)
+    {
+        return 0;
+    }
+
+    for (int32_t i = common_index_first_child((int32_t)index); i != COMMON_INDEX_EMPTY_SLOT; i = common_index_next_sibling(i))
+    {
+        if (indices != NULL && count < max_indices)
+        {
+            indices[count] = (unsigned int)i;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+int fpga_get_next_in_tree(int root, int index)
+{
+    int size = (int)common_fpga_interface_info_vec_size();
+
+    if (root < -1 || root >= size || index < -1 || index >= size || (root >= 0 && common_fpga_interface_info_vec_at(root)->is_removed))
+    {
+        return -1;
+    }
+    if (index == -1)
+    {
+        return root >= 0 ? root : common_index_first_child(-1);
+    }
+
+    // the first child, otherwise the next sibling of the closest ancestor that has one, without leaving the subtree
+    int32_t next = common_index_first_child(index);
+    while (next == COMMON_INDEX_EMPTY_SLOT && index != root && index >= 0)
+    {
+        next = common_index_next_sibling(index);
+        index = common_fpga_interface_info_vec_at(index)->dfh_parent;
+    }
+
+    return next;
+}
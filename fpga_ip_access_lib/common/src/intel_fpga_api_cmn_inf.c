@@ -34,10 +34,15 @@
 
 #include "intel_fpga_api_cmn_msg.h"
 #include "intel_fpga_api_cmn_inf.h"
+#include "intel_fpga_api_cmn_arch.h"
+#include "intel_fpga_api_cmn_shadow.h"
+#include "intel_fpga_api_cmn_arena.h"
+#include "intel_fpga_api_cmn_index.h"
 
 FPGA_INTERFACE_INFO     *g_common_fpga_interface_info_vec = NULL;
 size_t                  g_common_fpga_interface_info_vec_size = 0;
 size_t                  g_common_fpga_interface_info_vec_reserved = 0;
+COMMON_FPGA_INTERFACE_HOT *g_common_fpga_interface_hot_vec = NULL;
 
 
 unsigned int fpga_get_num_of_interfaces()
@@ -48,7 +53,7 @@ unsigned int fpga_get_num_of_interfaces()
 bool fpga_get_interface_at(unsigned int index, FPGA_INTERFACE_INFO *info)
 {
     bool ret = false;
-    if (index < common_fpga_interface_info_vec_size() && info != NULL)
+    if (index < common_fpga_interface_info_vec_size() && info != NULL && !common_fpga_interface_info_vec_at(index)->is_removed)
     {
         memcpy(info, common_fpga_interface_info_vec_at(index), sizeof(FPGA_INTERFACE_INFO));
         
@@ -58,15 +63,83 @@ bool fpga_get_interface_at(unsigned int index, FPGA_INTERFACE_INFO *info)
     return ret;
 }
 
+const FPGA_INTERFACE_INFO *fpga_interface_view(unsigned int index)
+{
+    if (index >= common_fpga_interface_info_vec_size() || common_fpga_interface_info_vec_at(index)->is_removed)
+    {
+        return NULL;
+    }
+
+    return common_fpga_interface_info_vec_at(index);
+}
+
+const FPGA_INTERFACE_PARAMETER *fpga_get_parameter(unsigned int index, uint16_t param_id, uint16_t version_min)
+{
+    if (index >= common_fpga_interface_info_vec_size() || common_fpga_interface_info_vec_at(index)->is_removed)
+    {
+        return NULL;
+    }
+
+    FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(index);
+    const FPGA_INTERFACE_PARAMETER *param = NULL;
+    if (info->param_order != NULL)
+    {
+        // lower bound of param_id; the first match has the highest version
+        size_t low = 0;
+        size_t high = info->num_of_parameters;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (info->parameters[info->param_order[mid]].param_id < param_id)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        if (low < info->num_of_parameters && info->parameters[info->param_order[low]].param_id == param_id)
+        {
+            param = &info->parameters[info->param_order[low]];
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < info->num_of_parameters; i++)
+        {
+            if (info->parameters[i].param_id == param_id && (param == NULL || info->parameters[i].version > param->version))
+            {
+                param = &info->parameters[i];
+            }
+        }
+    }
+
+    return param != NULL && param->version >= version_min ? param : NULL;
+}
+
+// The open flags are claimed with compare-and-swap so that two threads opening the same interface cannot both succeed.
+// The acquire/release pair orders the accesses of the previous owner before the accesses of the next one.
+static bool common_claim(bool *opened)
+{
+    bool expected = false;
+    return __atomic_compare_exchange_n(opened, &expected, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+static void common_release(bool *opened)
+{
+    __atomic_store_n(opened, false, __ATOMIC_RELEASE);
+}
+
 FPGA_MMIO_INTERFACE_HANDLE fpga_open(unsigned int index)
 {
     FPGA_MMIO_INTERFACE_HANDLE  ret = FPGA_MMIO_INTERFACE_INVALID_HANDLE;
     
-    if (index < common_fpga_interface_info_vec_size() &&
-        !common_fpga_interface_info_vec_at(index)->is_mmio_opened )
+    if (index < common_fpga_interface_info_vec_size() && !common_fpga_interface_info_vec_at(index)->is_removed &&
+        common_claim(&common_fpga_interface_info_vec_at(index)->is_mmio_opened) )
     {
+        common_fpga_interface_hot_update(index);
         ret = index;
-        common_fpga_interface_info_vec_at(index)->is_mmio_opened = true;
     }
     
     return ret;
@@ -76,7 +149,7 @@ void fpga_close(unsigned int index)
 {
     if (index < common_fpga_interface_info_vec_size() )
     {
-        common_fpga_interface_info_vec_at(index)->is_mmio_opened = false;
+        common_release(&common_fpga_interface_info_vec_at(index)->is_mmio_opened);
     }
 }
 
@@ -84,11 +157,10 @@ FPGA_INTERRUPT_HANDLE fpga_interrupt_open(unsigned int index)
 {
     FPGA_INTERRUPT_HANDLE  ret = FPGA_INTERRUPT_INVALID_HANDLE;
     
-    if (index < common_fpga_interface_info_vec_size() &&
-        !common_fpga_interface_info_vec_at(index)->is_interrupt_opened )
+    if (index < common_fpga_interface_info_vec_size() && !common_fpga_interface_info_vec_at(index)->is_removed &&
+        common_claim(&common_fpga_interface_info_vec_at(index)->is_interrupt_opened) )
     {
         ret = index;
-        common_fpga_interface_info_vec_at(index)->is_interrupt_opened = true;
     }
     
     return ret;
@@ -98,10 +170,90 @@ void fpga_interrupt_close(unsigned int index)
 {
     if (index < common_fpga_interface_info_vec_size() )
     {
-        common_fpga_interface_info_vec_at(index)->is_interrupt_opened = false;
+        common_release(&common_fpga_interface_info_vec_at(index)->is_interrupt_opened);
     }
 }
 
+// The interface lock is a ticket lock: each locker takes the next ticket and spins until it is served, so the waiters
+// are granted the lock in arrival order.  Zephyr uses k_spinlock, which also masks the interrupts of the local CPU so that
+// the holder cannot be preempted by a waiter on a single-core system.
+int fpga_lock(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(handle);
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+        uint32_t ticket = __atomic_fetch_add(&info->lock_ticket, 1, __ATOMIC_RELAXED);
+        while (__atomic_load_n(&info->lock_serving, __ATOMIC_ACQUIRE) != ticket)
+        {
+            common_cpu_relax();
+        }
+#else
+        k_spinlock_key_t key = k_spin_lock(&info->lock);
+        info->lock_key = key;
+#endif
+        ret = 0;
+    }
+
+    return ret;
+}
+
+int fpga_trylock(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(handle);
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+        uint32_t serving = __atomic_load_n(&info->lock_serving, __ATOMIC_RELAXED);
+        uint32_t ticket = serving;
+        ret = __atomic_compare_exchange_n(&info->lock_ticket, &ticket, serving + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) ? 0 : 1;
+#else
+        k_spinlock_key_t key;
+        ret = 1;
+        if (k_spin_trylock(&info->lock, &key) == 0)
+        {
+            info->lock_key = key;
+            ret = 0;
+        }
+#endif
+    }
+
+    return ret;
+}
+
+int fpga_unlock(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(handle);
+#ifndef ZEPHYR_FPGA_IP_ACCESS
+        // Only the holder advances lock_serving.
+        __atomic_store_n(&info->lock_serving, info->lock_serving + 1, __ATOMIC_RELEASE);
+#else
+        k_spin_unlock(&info->lock, info->lock_key);
+#endif
+        ret = 0;
+    }
+
+    return ret;
+}
+
+int fpga_set_64bit_emulation(FPGA_MMIO_INTERFACE_HANDLE handle, bool enable)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        common_fpga_interface_info_vec_at(handle)->emulate_64bit = enable;
+        common_fpga_interface_hot_update(handle);
+        ret = 0;
+    }
+
+    return ret;
+}
+
 void common_fpga_interface_info_vec_resize(size_t size)
 {
     common_fpga_interface_info_vec_reserve(size);
@@ -113,13 +265,15 @@ void common_fpga_interface_info_vec_reserve(size_t size)
     if (size > g_common_fpga_interface_info_vec_reserved)
     {
         g_common_fpga_interface_info_vec = realloc(g_common_fpga_interface_info_vec, size * sizeof(FPGA_INTERFACE_INFO));
-        if (g_common_fpga_interface_info_vec == NULL)
+        g_common_fpga_interface_hot_vec = realloc(g_common_fpga_interface_hot_vec, size * sizeof(COMMON_FPGA_INTERFACE_HOT));
+        if (g_common_fpga_interface_info_vec == NULL || g_common_fpga_interface_hot_vec == NULL)
         {
             fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for %d interfaces.", size);
         }
         else
         {
             memset(g_common_fpga_interface_info_vec + g_common_fpga_interface_info_vec_reserved, 0, (size - g_common_fpga_interface_info_vec_reserved) * sizeof(FPGA_INTERFACE_INFO));
+            memset(g_common_fpga_interface_hot_vec + g_common_fpga_interface_info_vec_reserved, 0, (size - g_common_fpga_interface_info_vec_reserved) * sizeof(COMMON_FPGA_INTERFACE_HOT));
             g_common_fpga_interface_info_vec_reserved = size;
         }
     }
@@ -127,16 +281,14 @@ void common_fpga_interface_info_vec_reserve(size_t size)
     {
         if (size < g_common_fpga_interface_info_vec_size)
         {
+            common_index_clear();
             for (int i = size; i < g_common_fpga_interface_info_vec_size; i++)
             {
-                size_t parameter_block_count = common_fpga_interface_info_vec_at(i)->num_of_parameters;
-                for (int j = 0; j < parameter_block_count; j++)
-                {
-                    free(common_fpga_interface_info_vec_at(i)->parameters[j].data);
-                }
-                free(common_fpga_interface_info_vec_at(i)->parameters);   
+                // parameters live in the arena, which is released as a whole below
+                common_shadow_free(common_fpga_interface_info_vec_at(i)->shadow);
             }
             memset(g_common_fpga_interface_info_vec + size, 0, (g_common_fpga_interface_info_vec_size - size) * sizeof(FPGA_INTERFACE_INFO));
+            memset(g_common_fpga_interface_hot_vec + size, 0, (g_common_fpga_interface_info_vec_size - size) * sizeof(COMMON_FPGA_INTERFACE_HOT));
             g_common_fpga_interface_info_vec_size = size;
         }
 
@@ -147,8 +299,17 @@ void common_fpga_interface_info_vec_reserve(size_t size)
                 free(g_common_fpga_interface_info_vec);
             }
             g_common_fpga_interface_info_vec = NULL;
+            free(g_common_fpga_interface_hot_vec);
+            g_common_fpga_interface_hot_vec = NULL;
             g_common_fpga_interface_info_vec_reserved = 0;
             g_common_fpga_interface_info_vec_size = 0;
+            common_arena_release();
         }
     }
 }
+
+void common_fpga_interface_hot_update(size_t index)
+{
+    common_fpga_interface_hot_at(index)->base = (volatile uint8_t *)common_fpga_interface_info_vec_at(index)->base_address;
+    common_fpga_interface_hot_at(index)->emulate_64bit = common_fpga_interface_info_vec_at(index)->emulate_64bit;
+}
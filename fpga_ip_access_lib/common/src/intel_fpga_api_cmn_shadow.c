@@ -0,0 +1,432 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intel_fpga_api.h"
+#include "intel_fpga_api_cmn_shadow.h"
+
+typedef struct
+{
+    uint32_t                     offset;
+    uint32_t                     size;
+    uint32_t                     *value;        // One entry per 32-bit register
+    bool                         *valid;
+} COMMON_SHADOW_RANGE;
+
+typedef struct
+{
+    COMMON_SHADOW_RANGE          *ranges;
+    size_t                       num_of_ranges;
+    FPGA_SHADOW_STATS            stats;
+} COMMON_SHADOW;
+
+static bool common_shadow_is_handle_valid(FPGA_MMIO_INTERFACE_HANDLE handle);
+static COMMON_SHADOW *common_shadow_of(FPGA_MMIO_INTERFACE_HANDLE handle);
+static COMMON_SHADOW_RANGE *common_shadow_find(COMMON_SHADOW *shadow, uint32_t offset, uint32_t size);
+
+bool common_shadow_is_handle_valid(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    return handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size();
+}
+
+COMMON_SHADOW *common_shadow_of(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    return (COMMON_SHADOW *)common_fpga_interface_info_vec_at(handle)->shadow;
+}
+
+COMMON_SHADOW_RANGE *common_shadow_find(COMMON_SHADOW *shadow, uint32_t offset, uint32_t size)
+{
+    size_t i;
+
+    if (shadow != NULL)
+    {
+        for (i = 0; i < shadow->num_of_ranges; ++i)
+        {
+            COMMON_SHADOW_RANGE *range = &shadow->ranges[i];
+
+            if (offset >= range->offset && (uint64_t)offset + size <= (uint64_t)range->offset + range->size)
+            {
+                return range;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+int fpga_shadow_add_range(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t size)
+{
+    int ret = -1;
+    if (common_shadow_is_handle_valid(handle))
+    {
+        COMMON_SHADOW *shadow = common_shadow_of(handle);
+        COMMON_SHADOW_RANGE *range;
+        size_t i;
+
+        if ((offset % 4) != 0 || (size % 4) != 0 || size == 0)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "shadow range 0x%X:0x%X is not 32-bit aligned.", offset, size);
+            return -1;
+        }
+
+        if (shadow == NULL)
+        {
+            shadow = calloc(1, sizeof(COMMON_SHADOW));
+            if (shadow == NULL)
+            {
+                fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for the register shadow.");
+                return -1;
+            }
+            common_fpga_interface_info_vec_at(handle)->shadow = shadow;
+        }
+
+        for (i = 0; i < shadow->num_of_ranges; ++i)
+        {
+            if ((uint64_t)offset < (uint64_t)shadow->ranges[i].offset + shadow->ranges[i].size &&
+                (uint64_t)shadow->ranges[i].offset < (uint64_t)offset + size)
+            {
+                fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "shadow range 0x%X:0x%X overlaps an existing range.", offset, size);
+                return -1;
+            }
+        }
+
+        range = realloc(shadow->ranges, (shadow->num_of_ranges + 1) * sizeof(COMMON_SHADOW_RANGE));
+        if (range == NULL)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for the register shadow.");
+            return -1;
+        }
+        shadow->ranges = range;
+
+        range = &shadow->ranges[shadow->num_of_ranges];
+        range->offset = offset;
+        range->size = size;
+        range->value = calloc(size / 4, sizeof(uint32_t));
+        range->valid = calloc(size / 4, sizeof(bool));
+        if (range->value == NULL || range->valid == NULL)
+        {
+            free(range->value);
+            free(range->valid);
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "insufficient memory for the register shadow.");
+            return -1;
+        }
+        ++shadow->num_of_ranges;
+
+        ret = 0;
+    }
+
+    return ret;
+}
+
+uint32_t fpga_shadow_read_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+{
+    COMMON_SHADOW *shadow;
+    COMMON_SHADOW_RANGE *range;
+    uint32_t ret;
+
+    if (!common_shadow_is_handle_valid(handle))
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid interface handle %d.", handle);
+        return 0;
+    }
+
+    if ((offset % 4) != 0)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "shadow offset 0x%X is not 32-bit aligned.", offset);
+        return 0;
+    }
+
+    shadow = common_shadow_of(handle);
+    range = common_shadow_find(shadow, offset, 4);
+
+    if (range != NULL)
+    {
+        size_t i = (offset - range->offset) / 4;
+
+        if (range->valid[i])
+        {
+            ++shadow->stats.avoided_reads;
+            return range->value[i];
+        }
+        ret = fpga_read_32(handle, offset);
+        range->value[i] = ret;
+        range->valid[i] = true;
+    }
+    else
+    {
+        ret = fpga_read_32(handle, offset);
+    }
+
+    if (shadow != NULL)
+    {
+        ++shadow->stats.reads;
+    }
+
+    return ret;
+}
+
+uint64_t fpga_shadow_read_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+{
+    COMMON_SHADOW *shadow;
+    COMMON_SHADOW_RANGE *range;
+    uint64_t ret;
+
+    if (!common_shadow_is_handle_valid(handle))
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid interface handle %d.", handle);
+        return 0;
+    }
+
+    if ((offset % 4) != 0)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "shadow offset 0x%X is not 32-bit aligned.", offset);
+        return 0;
+    }
+
+    shadow = common_shadow_of(handle);
+    range = common_shadow_find(shadow, offset, 8);
+
+    if (range != NULL)
+    {
+        size_t i = (offset - range->offset) / 4;
+
+        if (range->valid[i] && range->valid[i + 1])
+        {
+            ++shadow->stats.avoided_reads;
+            return range->value[i] | ((uint64_t)range->value[i + 1] << 32);
+        }
+        ret = fpga_read_64(handle, offset);
+        range->value[i] = (uint32_t)ret;
+        range->value[i + 1] = (uint32_t)(ret >> 32);
+        range->valid[i] = true;
+        range->valid[i + 1] = true;
+    }
+    else
+    {
+        ret = fpga_read_64(handle, offset);
+    }
+
+    if (shadow != NULL)
+    {
+        ++shadow->stats.reads;
+    }
+
+    return ret;
+}
+
+void fpga_shadow_write_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t value)
+{
+    COMMON_SHADOW *shadow;
+    COMMON_SHADOW_RANGE *range;
+
+    if (!common_shadow_is_handle_valid(handle))
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid interface handle %d.", handle);
+        return;
+    }
+
+    if ((offset % 4) != 0)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "shadow offset 0x%X is not 32-bit aligned.", offset);
+        return;
+    }
+
+    shadow = common_shadow_of(handle);
+    range = common_shadow_find(shadow, offset, 4);
+
+    fpga_write_32(handle, offset, value);
+
+    if (range != NULL)
+    {
+        size_t i = (offset - range->offset) / 4;
+
+        range->value[i] = value;
+        range->valid[i] = true;
+    }
+
+    if (shadow != NULL)
+    {
+        ++shadow->stats.writes;
+    }
+}
+
+void fpga_shadow_write_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint64_t value)
+{
+    COMMON_SHADOW *shadow;
+    COMMON_SHADOW_RANGE *range;
+
+    if (!common_shadow_is_handle_valid(handle))
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid interface handle %d.", handle);
+        return;
+    }
+
+    if ((offset % 4) != 0)
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "shadow offset 0x%X is not 32-bit aligned.", offset);
+        return;
+    }
+
+    shadow = common_shadow_of(handle);
+    range = common_shadow_find(shadow, offset, 8);
+
+    fpga_write_64(handle, offset, value);
+
+    if (range != NULL)
+    {
+        size_t i = (offset - range->offset) / 4;
+
+        range->value[i] = (uint32_t)value;
+        range->value[i + 1] = (uint32_t)(value >> 32);
+        range->valid[i] = true;
+        range->valid[i + 1] = true;
+    }
+
+    if (shadow != NULL)
+    {
+        ++shadow->stats.writes;
+    }
+}
+
+uint32_t fpga_rmw_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t clear, uint32_t set)
+{
+    uint32_t value;
+
+    if (!common_shadow_is_handle_valid(handle))
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid interface handle %d.", handle);
+        return 0;
+    }
+
+    value = (fpga_shadow_read_32(handle, offset) & ~clear) | set;
+
+    fpga_shadow_write_32(handle, offset, value);
+
+    return value;
+}
+
+uint64_t fpga_rmw_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint64_t clear, uint64_t set)
+{
+    uint64_t value;
+
+    if (!common_shadow_is_handle_valid(handle))
+    {
+        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid interface handle %d.", handle);
+        return 0;
+    }
+
+    value = (fpga_shadow_read_64(handle, offset) & ~clear) | set;
+
+    fpga_shadow_write_64(handle, offset, value);
+
+    return value;
+}
+
+int fpga_shadow_invalidate(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    int ret = -1;
+    if (common_shadow_is_handle_valid(handle))
+    {
+        COMMON_SHADOW *shadow = common_shadow_of(handle);
+        size_t i;
+
+        for (i = 0; shadow != NULL && i < shadow->num_of_ranges; ++i)
+        {
+            memset(shadow->ranges[i].valid, 0, shadow->ranges[i].size / 4 * sizeof(bool));
+        }
+        ret = 0;
+    }
+
+    return ret;
+}
+
+int fpga_shadow_refresh(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    int ret = -1;
+    if (common_shadow_is_handle_valid(handle))
+    {
+        COMMON_SHADOW *shadow = common_shadow_of(handle);
+        size_t i;
+        uint32_t j;
+
+        for (i = 0; shadow != NULL && i < shadow->num_of_ranges; ++i)
+        {
+            COMMON_SHADOW_RANGE *range = &shadow->ranges[i];
+
+            for (j = 0; j < range->size / 4; ++j)
+            {
+                range->value[j] = fpga_read_32(handle, range->offset + j * 4);
+                range->valid[j] = true;
+            }
+            shadow->stats.reads += range->size / 4;
+        }
+        ret = 0;
+    }
+
+    return ret;
+}
+
+int fpga_shadow_get_stats(FPGA_MMIO_INTERFACE_HANDLE handle, FPGA_SHADOW_STATS *stats)
+{
+    int ret = -1;
+    if (common_shadow_is_handle_valid(handle) && stats != NULL)
+    {
+        COMMON_SHADOW *shadow = common_shadow_of(handle);
+
+        if (shadow != NULL)
+        {
+            *stats = shadow->stats;
+        }
+        else
+        {
+            memset(stats, 0, sizeof(FPGA_SHADOW_STATS));
+        }
+        ret = 0;
+    }
+
+    return ret;
+}
+
+void common_shadow_free(void *shadow)
+{
+    COMMON_SHADOW *s = (COMMON_SHADOW *)shadow;
+    size_t i;
+
+    if (s != NULL)
+    {
+        for (i = 0; i < s->num_of_ranges; ++i)
+        {
+            free(s->ranges[i].value);
+            free(s->ranges[i].valid);
+        }
+        free(s->ranges);
+        free(s);
+    }
+}
@@ -0,0 +1,437 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "intel_fpga_api_cmn_wide.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define COMMON_MMIO_WIDE_X86
+#endif
+
+static COMMON_MMIO_WIDE_PATH    s_mmio_wide_path = COMMON_MMIO_WIDE_PATH_NONE;
+static bool                     s_mmio_wide_path_selected = false;
+
+// Keep the compiler from moving other MMIO accesses across the vector access.  The intrinsics take
+// non-volatile pointers, but each one still issues exactly one load or store instruction.
+#define COMMON_MMIO_WIDE_COMPILER_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+#ifdef COMMON_MMIO_WIDE_X86
+
+__attribute__((target("avx512f")))
+static void s_mmio_read_512_avx512(const volatile void *src, uint8_t *value)
+{
+    __m512i data;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    data = _mm512_stream_load_si512((void *)(uintptr_t)src);
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    _mm512_storeu_si512((void *)value, data);
+}
+
+__attribute__((target("avx512f")))
+static void s_mmio_write_512_avx512(volatile void *dst, const uint8_t *value)
+{
+    __m512i data = _mm512_loadu_si512((const void *)value);
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    _mm512_stream_si512((void *)(uintptr_t)dst, data);
+    _mm_sfence();
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+__attribute__((target("avx2")))
+static void s_mmio_read_512_avx2(const volatile void *src, uint8_t *value)
+{
+    __m256i data_l;
+    __m256i data_h;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    data_l = _mm256_stream_load_si256((__m256i *)(uintptr_t)src);
+    data_h = _mm256_stream_load_si256((__m256i *)(uintptr_t)src + 1);
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    _mm256_storeu_si256((__m256i *)value, data_l);
+    _mm256_storeu_si256((__m256i *)value + 1, data_h);
+}
+
+__attribute__((target("avx2")))
+static void s_mmio_write_512_avx2(volatile void *dst, const uint8_t *value)
+{
+    __m256i data_l = _mm256_loadu_si256((const __m256i *)value);
+    __m256i data_h = _mm256_loadu_si256((const __m256i *)value + 1);
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    _mm256_stream_si256((__m256i *)(uintptr_t)dst, data_l);
+    _mm256_stream_si256((__m256i *)(uintptr_t)dst + 1, data_h);
+    _mm_sfence();
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+__attribute__((target("sse2")))
+static void s_mmio_read_512_sse2(const volatile void *src, uint8_t *value)
+{
+    __m128i data[4];
+    int     i;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < 4; ++i)
+    {
+        data[i] = _mm_load_si128((__m128i *)(uintptr_t)src + i);
+    }
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < 4; ++i)
+    {
+        _mm_storeu_si128((__m128i *)value + i, data[i]);
+    }
+}
+
+__attribute__((target("sse2")))
+static void s_mmio_write_512_sse2(volatile void *dst, const uint8_t *value)
+{
+    __m128i data[4];
+    int     i;
+
+    for (i = 0; i < 4; ++i)
+    {
+        data[i] = _mm_loadu_si128((const __m128i *)value + i);
+    }
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < 4; ++i)
+    {
+        _mm_stream_si128((__m128i *)(uintptr_t)dst + i, data[i]);
+    }
+    _mm_sfence();
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+__attribute__((target("avx512f")))
+static void s_mmio_copy_from_io_avx512(uint8_t *dst, const volatile uint8_t *src, size_t len)
+{
+    size_t  i;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < len; i += 64)
+    {
+        _mm512_storeu_si512((void *)(dst + i), _mm512_stream_load_si512((void *)(uintptr_t)(src + i)));
+    }
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+__attribute__((target("avx512f")))
+static void s_mmio_copy_to_io_avx512(volatile uint8_t *dst, const uint8_t *src, size_t len)
+{
+    size_t  i;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < len; i += 64)
+    {
+        _mm512_stream_si512((void *)(uintptr_t)(dst + i), _mm512_loadu_si512((const void *)(src + i)));
+    }
+    _mm_sfence();
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+__attribute__((target("avx2")))
+static void s_mmio_copy_from_io_avx2(uint8_t *dst, const volatile uint8_t *src, size_t len)
+{
+    size_t  i;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < len; i += 32)
+    {
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_stream_load_si256((__m256i *)(uintptr_t)(src + i)));
+    }
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+__attribute__((target("avx2")))
+static void s_mmio_copy_to_io_avx2(volatile uint8_t *dst, const uint8_t *src, size_t len)
+{
+    size_t  i;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < len; i += 32)
+    {
+        _mm256_stream_si256((__m256i *)(uintptr_t)(dst + i), _mm256_loadu_si256((const __m256i *)(src + i)));
+    }
+    _mm_sfence();
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+__attribute__((target("sse2")))
+static void s_mmio_copy_from_io_sse2(uint8_t *dst, const volatile uint8_t *src, size_t len)
+{
+    size_t  i;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < len; i += 16)
+    {
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_load_si128((__m128i *)(uintptr_t)(src + i)));
+    }
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+__attribute__((target("sse2")))
+static void s_mmio_copy_to_io_sse2(volatile uint8_t *dst, const uint8_t *src, size_t len)
+{
+    size_t  i;
+
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+    for (i = 0; i < len; i += 16)
+    {
+        _mm_stream_si128((__m128i *)(uintptr_t)(dst + i), _mm_loadu_si128((const __m128i *)(src + i)));
+    }
+    _mm_sfence();
+    COMMON_MMIO_WIDE_COMPILER_BARRIER();
+}
+
+static size_t s_mmio_wide_path_bytes(COMMON_MMIO_WIDE_PATH path)
+{
+    switch (path)
+    {
+        case COMMON_MMIO_WIDE_PATH_AVX512:
+            return 64;
+        case COMMON_MMIO_WIDE_PATH_AVX2:
+            return 32;
+        case COMMON_MMIO_WIDE_PATH_SSE2:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+#endif  // COMMON_MMIO_WIDE_X86
+
+COMMON_MMIO_WIDE_PATH common_mmio_wide_path()
+{
+    // Concurrent first callers may both select; each publishes the same path, and a caller seeing the flag set
+    // through the acquire load also sees the path stored before it.
+    if (!__atomic_load_n(&s_mmio_wide_path_selected, __ATOMIC_ACQUIRE))
+    {
+        COMMON_MMIO_WIDE_PATH path = COMMON_MMIO_WIDE_PATH_NONE;
+
+#ifdef COMMON_MMIO_WIDE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            path = COMMON_MMIO_WIDE_PATH_AVX512;
+        }
+        else if (__builtin_cpu_supports("avx2"))
+        {
+            path = COMMON_MMIO_WIDE_PATH_AVX2;
+        }
+        else if (__builtin_cpu_supports("sse2"))
+        {
+            path = COMMON_MMIO_WIDE_PATH_SSE2;
+        }
+#endif
+        __atomic_store_n(&s_mmio_wide_path, path, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_mmio_wide_path_selected, true, __ATOMIC_RELEASE);
+        return path;
+    }
+
+    return __atomic_load_n(&s_mmio_wide_path, __ATOMIC_RELAXED);
+}
+
+bool common_mmio_read_512(const volatile void *src, uint8_t *value)
+{
+#ifdef COMMON_MMIO_WIDE_X86
+    uintptr_t addr = (uintptr_t)src;
+
+    // Use the widest path the address alignment allows; non-temporal vector accesses must be naturally aligned.
+    switch (common_mmio_wide_path())
+    {
+        case COMMON_MMIO_WIDE_PATH_AVX512:
+            if ((addr & 63) == 0)
+            {
+                s_mmio_read_512_avx512(src, value);
+                return true;
+            }
+            // fall through
+        case COMMON_MMIO_WIDE_PATH_AVX2:
+            if ((addr & 31) == 0)
+            {
+                s_mmio_read_512_avx2(src, value);
+                return true;
+            }
+            // fall through
+        case COMMON_MMIO_WIDE_PATH_SSE2:
+            if ((addr & 15) == 0)
+            {
+                s_mmio_read_512_sse2(src, value);
+                return true;
+            }
+            // fall through
+        default:
+            break;
+    }
+#else
+    (void)src;
+    (void)value;
+#endif
+
+    return false;
+}
+
+bool common_mmio_write_512(volatile void *dst, const uint8_t *value)
+{
+#ifdef COMMON_MMIO_WIDE_X86
+    uintptr_t addr = (uintptr_t)dst;
+
+    switch (common_mmio_wide_path())
+    {
+        case COMMON_MMIO_WIDE_PATH_AVX512:
+            if ((addr & 63) == 0)
+            {
+                s_mmio_write_512_avx512(dst, value);
+                return true;
+            }
+            // fall through
+        case COMMON_MMIO_WIDE_PATH_AVX2:
+            if ((addr & 31) == 0)
+            {
+                s_mmio_write_512_avx2(dst, value);
+                return true;
+            }
+            // fall through
+        case COMMON_MMIO_WIDE_PATH_SSE2:
+            if ((addr & 15) == 0)
+            {
+                s_mmio_write_512_sse2(dst, value);
+                return true;
+            }
+            // fall through
+        default:
+            break;
+    }
+#else
+    (void)dst;
+    (void)value;
+#endif
+
+    return false;
+}
+
+void common_mmio_copy_from_io(void *dst, const volatile void *src, size_t len)
+{
+    uint8_t                 *host = (uint8_t *)dst;
+    const volatile uint8_t  *io = (const volatile uint8_t *)src;
+    uint64_t                data;
+
+#ifdef COMMON_MMIO_WIDE_X86
+    COMMON_MMIO_WIDE_PATH   path = common_mmio_wide_path();
+    size_t                  bytes = s_mmio_wide_path_bytes(path);
+    size_t                  n;
+
+    if (bytes != 0)
+    {
+        // Walk up to the vector alignment with 64-bit reads, then stream the rest.
+        while (len >= 8 && ((uintptr_t)io & (bytes - 1)) != 0)
+        {
+            data = *((const volatile uint64_t *)io);
+            memcpy(host, &data, 8);
+            host += 8;
+            io += 8;
+            len -= 8;
+        }
+
+        n = len & ~(bytes - 1);
+        if (n != 0)
+        {
+            if (path == COMMON_MMIO_WIDE_PATH_AVX512)
+                s_mmio_copy_from_io_avx512(host, io, n);
+            else if (path == COMMON_MMIO_WIDE_PATH_AVX2)
+                s_mmio_copy_from_io_avx2(host, io, n);
+            else
+                s_mmio_copy_from_io_sse2(host, io, n);
+            host += n;
+            io += n;
+            len -= n;
+        }
+    }
+#endif
+
+    while (len >= 8)
+    {
+        data = *((const volatile uint64_t *)io);
+        memcpy(host, &data, 8);
+        host += 8;
+        io += 8;
+        len -= 8;
+    }
+}
+
+void common_mmio_copy_to_io(volatile void *dst, const void *src, size_t len)
+{
+    volatile uint8_t        *io = (volatile uint8_t *)dst;
+    const uint8_t           *host = (const uint8_t *)src;
+    uint64_t                data;
+
+#ifdef COMMON_MMIO_WIDE_X86
+    COMMON_MMIO_WIDE_PATH   path = common_mmio_wide_path();
+    size_t                  bytes = s_mmio_wide_path_bytes(path);
+    size_t                  n;
+
+    if (bytes != 0)
+    {
+        while (len >= 8 && ((uintptr_t)io & (bytes - 1)) != 0)
+        {
+            memcpy(&data, host, 8);
+            *((volatile uint64_t *)io) = data;
+            host += 8;
+            io += 8;
+            len -= 8;
+        }
+
+        n = len & ~(bytes - 1);
+        if (n != 0)
+        {
+            if (path == COMMON_MMIO_WIDE_PATH_AVX512)
+                s_mmio_copy_to_io_avx512(io, host, n);
+            else if (path == COMMON_MMIO_WIDE_PATH_AVX2)
+                s_mmio_copy_to_io_avx2(io, host, n);
+            else
+                s_mmio_copy_to_io_sse2(io, host, n);
+            host += n;
+            io += n;
+            len -= n;
+        }
+    }
+#endif
+
+    while (len >= 8)
+    {
+        memcpy(&data, host, 8);
+        *((volatile uint64_t *)io) = data;
+        host += 8;
+        io += 8;
+        len -= 8;
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright(c) 2023, Intel Corporation
+//
+// Redistribution  and  use  in source  and  binary  forms,  with  or  without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of  source code  must retain the  above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the name  of Intel Corporation  nor the names of its contributors
+//   may be used to  endorse or promote  products derived  from this  software
+//   without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+// IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT  SHALL THE COPYRIGHT OWNER  OR CONTRIBUTORS BE
+// LIABLE  FOR  ANY  DIRECT,  INDIRECT,  INCIDENTAL,  SPECIAL,  EXEMPLARY,  OR
+// CONSEQUENTIAL  DAMAGES  (INCLUDING,  BUT  NOT LIMITED  TO,  PROCUREMENT  OF
+// SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE,  DATA, OR PROFITS;  OR BUSINESS
+// INTERRUPTION)  HOWEVER CAUSED  AND ON ANY THEORY  OF LIABILITY,  WHETHER IN
+// CONTRACT,  STRICT LIABILITY,  OR TORT  (INCLUDING NEGLIGENCE  OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,  EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "intel_fpga_api_cmn_dfl.h"
+#include "intel_fpga_api_cmn_dfl_image.h"
+
+// Scan a DFL ROM image file, raw or dumped with DFL_WALKER_DEBUG_MODE, and report the interfaces and the scan time.
+//   dfl-scan-image <image file> [<base address> [<JSON export file>]]
+int main(int argc, const char *argv[])
+{
+    struct timespec begin;
+    struct timespec end;
+    uint64_t base_address = 0;
+    int num_interfaces;
+
+    if (argc < 2 || argc > 4)
+    {
+        fprintf(stderr, "Usage: %s <image file> [<base address> [<JSON export file>]]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2)
+    {
+        base_address = strtoull(argv[2], NULL, 0);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    num_interfaces = common_dfl_image_scan(argv[1], DFL_IMAGE_AUTO, base_address);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (num_interfaces < 0)
+    {
+        return 1;
+    }
+
+    common_dfl_print_all_interfaces(common_dfl_image_base_addr_decoder);
+    printf("MMIO Interface(s) registered: %d\n", num_interfaces);
+    printf("Scan time: %ld us\n", (long)((end.tv_sec - begin.tv_sec) * 1000000 + (end.tv_nsec - begin.tv_nsec) / 1000));
+
+    if (argc > 3 && fpga_dfl_export(argv[3], FPGA_DFL_EXPORT_JSON) != 0)
+    {
+        num_interfaces = -1;
+    }
+
+    common_dfl_image_unload();
+    return num_interfaces < 0 ? 1 : 0;
+}
@@ -29,12 +29,18 @@
 #include <sstream>
 #include <iostream>
 #include <string.h>
+#include <vector>
+#include <unistd.h>
+#include <thread>
 using namespace std;
 
 #include "gtest/gtest.h"
 
 #include "intel_fpga_api_cmn_inf.h"
 #include "intel_fpga_api_cmn_dfl.h"
+#include "intel_fpga_api_cmn_index.h"
+#include "intel_fpga_api_cmn_dfl_export.h"
+#include "intel_fpga_api_cmn_dfl_image.h"
 
 #define NUM_INTERFACES 5
 #define MAX_PARAM_BLOCK 6
@@ -891,6 +897,745 @@ TEST_F(scan_hier_dfl, should_deal_with_two_branches_from_l1_to_l2_signed_positiv
     EXPECT_EQ((size_t)15, common_fpga_interface_info_vec_size());
 }
 
+// two branches from the same l1 interface -> l2; both l2 copies take that interface as parent
+TEST_F(scan_hier_dfl, should_deal_with_two_branches_from_same_interface_parent)
+{
+    link_l1_l2.absolute_0 = true;
+    link_l1_l2.absolute_0_interface_index = 1;
+    link_l1_l2.absolute_0_param_index = 0;
+
+    link_l1_l2.absolute_1 = true;
+    link_l1_l2.absolute_1_interface_index = 1;
+    link_l1_l2.absolute_1_param_index = 1;
+
+    create_hier_dfl(mem_block, 5);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)15, common_fpga_interface_info_vec_size());
+
+    for (int i = 0; i < 15; i++)
+    {
+        if (i >= 2 && i < 12)
+        {
+            EXPECT_EQ(1, common_fpga_interface_info_vec_at(i)->dfh_parent) << "differ at index " << i;
+        }
+        else
+        {
+            EXPECT_EQ(-1, common_fpga_interface_info_vec_at(i)->dfh_parent) << "differ at index " << i;
+        }
+    }
+}
+
+// parsing from the DFL ROM snapshot gives the same interfaces as parsing from the ROM
+TEST_F(scan_hier_dfl, should_deal_with_dfl_rom_snapshot)
+{
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    link_l2_l3.absolute_0 = true;
+    link_l2_l3.absolute_0_interface_index = 1;
+    link_l2_l3.absolute_0_param_index = 1;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    size_t num_interfaces = common_fpga_interface_info_vec_size();
+    EXPECT_EQ((size_t)15, num_interfaces);
+
+    FPGA_INTERFACE_INFO expected[15];
+    vector<vector<uint64_t>> expected_data(num_interfaces);
+    for (size_t i = 0; i < num_interfaces; i++)
+    {
+        expected[i] = *common_fpga_interface_info_vec_at(i);
+        for (size_t j = 0; j < expected[i].num_of_parameters; j++)
+        {
+            FPGA_INTERFACE_PARAMETER *param = &expected[i].parameters[j];
+            expected_data[i].push_back(((uint64_t)param->param_id << 32) | param->data_size);
+            expected_data[i].insert(expected_data[i].end(), param->data, param->data + param->data_size / sizeof(uint64_t));
+        }
+    }
+
+    const size_t snapshot_sizes[] = {0, sizeof(mem_block)};
+    for (size_t size : snapshot_sizes)
+    {
+        common_dfl_set_rom_snapshot(true, size);
+        common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+        ASSERT_EQ(num_interfaces, common_fpga_interface_info_vec_size()) << "snapshot size " << size;
+
+        for (size_t i = 0; i < num_interfaces; i++)
+        {
+            FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+            EXPECT_EQ(expected[i].base_address, info->base_address) << "differ at index " << i;
+            EXPECT_EQ(expected[i].guid.guid_l, info->guid.guid_l) << "differ at index " << i;
+            EXPECT_EQ(expected[i].guid.guid_h, info->guid.guid_h) << "differ at index " << i;
+            EXPECT_EQ(expected[i].instance_id, info->instance_id) << "differ at index " << i;
+            EXPECT_EQ(expected[i].group_id, info->group_id) << "differ at index " << i;
+            EXPECT_EQ(expected[i].dfh_parent, info->dfh_parent) << "differ at index " << i;
+
+            vector<uint64_t> data;
+            for (size_t j = 0; j < info->num_of_parameters; j++)
+            {
+                FPGA_INTERFACE_PARAMETER *param = &info->parameters[j];
+                data.push_back(((uint64_t)param->param_id << 32) | param->data_size);
+                data.insert(data.end(), param->data, param->data + param->data_size / sizeof(uint64_t));
+            }
+            EXPECT_EQ(expected_data[i], data) << "differ at index " << i;
+        }
+    }
+    common_dfl_set_rom_snapshot(false, 0);
+}
+
+// the parameter data point into the ROM snapshot, right behind their parameter header; the snapshot covers both levels
+TEST_F(scan_hier_dfl, should_view_parameters_in_the_dfl_rom_snapshot)
+{
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    size_t num_interfaces = common_fpga_interface_info_vec_size();
+    vector<vector<uint64_t>> expected_data(num_interfaces);
+    for (size_t i = 0; i < num_interfaces; i++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+        for (size_t j = 0; j < info->num_of_parameters; j++)
+        {
+            expected_data[i].insert(expected_data[i].end(), info->parameters[j].data, info->parameters[j].data + info->parameters[j].data_size / sizeof(uint64_t));
+        }
+    }
+
+    common_dfl_set_param_views(true);
+    common_dfl_set_rom_snapshot(true, sizeof(mem_block));
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ(num_interfaces, common_fpga_interface_info_vec_size());
+
+    size_t num_views = 0;
+    for (size_t i = 0; i < num_interfaces; i++)
+    {
+        const FPGA_INTERFACE_INFO *info = fpga_interface_view(i);
+        ASSERT_EQ(common_fpga_interface_info_vec_at(i), info);
+
+        vector<uint64_t> data;
+        for (size_t j = 0; j < info->num_of_parameters; j++)
+        {
+            const FPGA_INTERFACE_PARAMETER *param = &info->parameters[j];
+            if (param->data_size > 0)
+            {
+                EXPECT_EQ(param->param_id, (uint16_t)(param->data[-1] & 0xFFFF)) << "at interface " << i << ", parameter " << j;
+                num_views++;
+            }
+            data.insert(data.end(), param->data, param->data + param->data_size / sizeof(uint64_t));
+        }
+        EXPECT_EQ(expected_data[i], data) << "differ at index " << i;
+    }
+    EXPECT_GT(num_views, (size_t)0);
+    EXPECT_EQ(NULL, fpga_interface_view(num_interfaces));
+
+    common_dfl_set_param_views(false);
+    common_dfl_set_rom_snapshot(false, 0);
+}
+
+// a matching cache file is used instead of the DFL; a change in the leading DFHs triggers a walk and a new cache file
+TEST_F(scan_hier_dfl, should_deal_with_dfl_cache)
+{
+    string path = ::testing::TempDir() + "intel_fpga_api_dfl_cache_test.bin";
+    unlink(path.c_str());
+
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_set_cache_path(path.c_str());
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)10, common_fpga_interface_info_vec_size());
+    EXPECT_EQ(0, access(path.c_str(), R_OK));
+
+    // interface 3 is on level 2; a changed DFH there, as after a partial reconfiguration, is walked again
+    FPGA_INTERFACE_INFO expected = *common_fpga_interface_info_vec_at(3);
+    uint64_t *l1_guid_l = (uint64_t *)common_fpga_interface_info_vec_at(0)->dfh_address + 1;
+    uint64_t *l2_guid_l = (uint64_t *)expected.dfh_address + 1;
+    *l2_guid_l ^= 0xff;
+
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)10, common_fpga_interface_info_vec_size());
+    FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(3);
+    EXPECT_EQ(*l2_guid_l, info->guid.guid_l);
+    EXPECT_EQ(expected.guid.guid_h, info->guid.guid_h);
+    EXPECT_EQ(expected.base_address, info->base_address);
+    EXPECT_EQ(expected.dfh_address, info->dfh_address);
+    EXPECT_EQ(expected.dfh_parent, info->dfh_parent);
+    EXPECT_EQ(expected.instance_id, info->instance_id);
+    EXPECT_EQ(expected.group_id, info->group_id);
+    EXPECT_EQ(expected.num_of_parameters, info->num_of_parameters);
+
+    *l1_guid_l ^= 0xff;
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)10, common_fpga_interface_info_vec_size());
+    EXPECT_EQ(*l1_guid_l, common_fpga_interface_info_vec_at(0)->guid.guid_l);
+    EXPECT_EQ(*l2_guid_l, common_fpga_interface_info_vec_at(3)->guid.guid_l);
+
+    // the parameter data are not part of the key, so a table loaded from the cache keeps the data of the walk
+    uint64_t expected_param_data = common_fpga_interface_info_vec_at(3)->parameters[0].data[0];
+    uint64_t *l2_param_data = (uint64_t *)((uint8_t *)expected.dfh_address + 0x28 + 8);
+    *l2_param_data ^= 0xff;
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    EXPECT_EQ(expected_param_data, common_fpga_interface_info_vec_at(3)->parameters[0].data[0]);
+    *l2_param_data ^= 0xff;
+
+    // a walk stopped at a limit is not saved
+    unlink(path.c_str());
+    common_dfl_set_scan_limits(0, 3);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    EXPECT_EQ((size_t)3, common_fpga_interface_info_vec_size());
+    EXPECT_NE(0, access(path.c_str(), R_OK));
+
+    common_dfl_set_scan_limits(0, 0);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    EXPECT_EQ((size_t)10, common_fpga_interface_info_vec_size());
+    EXPECT_EQ(0, access(path.c_str(), R_OK));
+
+    common_dfl_set_cache_path(NULL);
+    unlink(path.c_str());
+}
+
+// with a ROM snapshot, the key is read from the snapshot and still sees a changed DFH on a branch
+TEST_F(scan_hier_dfl, should_deal_with_dfl_cache_with_rom_snapshot)
+{
+    string path = ::testing::TempDir() + "intel_fpga_api_dfl_cache_snapshot_test.bin";
+    unlink(path.c_str());
+
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_set_rom_snapshot(true, 0);
+    common_dfl_set_cache_path(path.c_str());
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)10, common_fpga_interface_info_vec_size());
+    EXPECT_EQ(0, access(path.c_str(), R_OK));
+
+    uint64_t *l2_guid_l = (uint64_t *)common_fpga_interface_info_vec_at(3)->dfh_address + 1;
+    *l2_guid_l ^= 0xff;
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)10, common_fpga_interface_info_vec_size());
+    EXPECT_EQ(*l2_guid_l, common_fpga_interface_info_vec_at(3)->guid.guid_l);
+
+    // a cached table is loaded
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)10, common_fpga_interface_info_vec_size());
+    EXPECT_EQ(*l2_guid_l, common_fpga_interface_info_vec_at(3)->guid.guid_l);
+
+    common_dfl_set_cache_path(NULL);
+    common_dfl_set_rom_snapshot(false, 0);
+    unlink(path.c_str());
+}
+
+static uint64_t dfl_base_addr_offset_decoder(uint64_t base_addr)
+{
+    return base_addr - (uint64_t)mem_block;
+}
+
+// the binary image and the JSON document hold the interface table, with the base addresses decoded
+TEST_F(scan_hier_dfl, should_export_the_interface_table)
+{
+    string binary_path = ::testing::TempDir() + "intel_fpga_api_dfl_export_test.bin";
+    string json_path = ::testing::TempDir() + "intel_fpga_api_dfl_export_test.json";
+
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_offset_decoder);
+    size_t num_interfaces = common_fpga_interface_info_vec_size();
+    ASSERT_EQ((size_t)(2 * NUM_INTERFACES), num_interfaces);
+
+    ASSERT_EQ(0, fpga_dfl_export(binary_path.c_str(), FPGA_DFL_EXPORT_BINARY));
+    FILE *file = fopen(binary_path.c_str(), "rb");
+    ASSERT_NE((FILE *)NULL, file);
+    vector<uint8_t> image(sizeof(mem_block) * 2);
+    image.resize(fread(image.data(), 1, image.size(), file));
+    fclose(file);
+
+    ASSERT_GE(image.size(), sizeof(DFL_EXPORT_HEADER));
+    const DFL_EXPORT_HEADER *header = (const DFL_EXPORT_HEADER *)image.data();
+    EXPECT_EQ(DFL_EXPORT_MAGIC, header->magic);
+    EXPECT_EQ((uint32_t)DFL_EXPORT_VERSION, header->version);
+    EXPECT_EQ(num_interfaces, header->num_of_interfaces);
+    EXPECT_EQ(image.size(), header->size);
+    EXPECT_EQ(0u, header->key);
+
+    const uint8_t *p = image.data() + sizeof(DFL_EXPORT_HEADER);
+    for (size_t i = 0; i < num_interfaces; i++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+        const DFL_EXPORT_INTERFACE *record = (const DFL_EXPORT_INTERFACE *)p;
+        EXPECT_EQ(info->guid.guid_l, record->guid_l) << "differ at index " << i;
+        EXPECT_EQ(info->guid.guid_h, record->guid_h) << "differ at index " << i;
+        EXPECT_EQ((uint64_t)info->dfh_address - (uint64_t)mem_block, record->dfh_address) << "differ at index " << i;
+        EXPECT_EQ((uint64_t)info->base_address - (uint64_t)mem_block, record->base_address) << "differ at index " << i;
+        EXPECT_EQ(info->dfh_parent, record->dfh_parent) << "differ at index " << i;
+        EXPECT_EQ(info->instance_id, record->instance_id) << "differ at index " << i;
+        EXPECT_EQ(info->group_id, record->group_id) << "differ at index " << i;
+        EXPECT_EQ((uint32_t)DFL_EXPORT_DFL, record->flags) << "differ at index " << i;
+        ASSERT_EQ(info->num_of_parameters, record->num_of_parameters) << "differ at index " << i;
+        p += sizeof(DFL_EXPORT_INTERFACE);
+
+        for (size_t j = 0; j < info->num_of_parameters; j++)
+        {
+            const DFL_EXPORT_PARAMETER *param = (const DFL_EXPORT_PARAMETER *)p;
+            EXPECT_EQ(info->parameters[j].param_id, param->param_id) << "differ at index " << i;
+            EXPECT_EQ(info->parameters[j].version, param->version) << "differ at index " << i;
+            ASSERT_EQ(info->parameters[j].data_size, param->data_size) << "differ at index " << i;
+            p += sizeof(DFL_EXPORT_PARAMETER);
+            EXPECT_EQ(0, memcmp(info->parameters[j].data, p, param->data_size)) << "differ at index " << i;
+            p += param->data_size;
+        }
+    }
+    EXPECT_EQ(image.data() + image.size(), p);
+
+    ASSERT_EQ(0, fpga_dfl_export(json_path.c_str(), FPGA_DFL_EXPORT_JSON));
+    file = fopen(json_path.c_str(), "r");
+    ASSERT_NE((FILE *)NULL, file);
+    string json(sizeof(mem_block) * 4, '\0');
+    json.resize(fread(&json[0], 1, json.size(), file));
+    fclose(file);
+
+    size_t num_objects = 0;
+    for (size_t pos = json.find("\"index\": "); pos != string::npos; pos = json.find("\"index\": ", pos + 1))
+    {
+        num_objects++;
+    }
+    EXPECT_EQ(num_interfaces, num_objects);
+
+    char expected[128];
+    FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(NUM_INTERFACES);
+    snprintf(expected, sizeof(expected), "\"guid\": \"%016lx%016lx\"", info->guid.guid_h, info->guid.guid_l);
+    EXPECT_NE(string::npos, json.find(expected)) << expected;
+    snprintf(expected, sizeof(expected), "\"base_address\": \"0x%lx\"", (uint64_t)info->base_address - (uint64_t)mem_block);
+    EXPECT_NE(string::npos, json.find(expected)) << expected;
+    EXPECT_NE(string::npos, json.find("\"parent\": 0,"));
+    EXPECT_EQ('}', json[json.find_last_not_of("\n")]);
+
+    EXPECT_EQ(-1, fpga_dfl_export(NULL, FPGA_DFL_EXPORT_JSON));
+    unlink(binary_path.c_str());
+    unlink(json_path.c_str());
+}
+
+// the raw image and the dfl_rom.txt dump of the DFL scan like the DFL itself, with the base addresses offset in the image
+TEST_F(scan_hier_dfl, should_scan_a_dfl_rom_image)
+{
+    string raw_path = ::testing::TempDir() + "intel_fpga_api_dfl_image_test.bin";
+    string text_path = ::testing::TempDir() + "intel_fpga_api_dfl_image_test.txt";
+    const uint64_t base_address = 0x40000;
+
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+    link_l2_l3.relative_0 = true;
+    link_l2_l3.relative_0_interface_index = 2;
+    link_l2_l3.relative_0_param_index = 1;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_offset_decoder);
+    vector<FPGA_INTERFACE_INFO> expected(common_fpga_interface_info_vec_at(0), common_fpga_interface_info_vec_at(0) + common_fpga_interface_info_vec_size());
+    ASSERT_EQ((size_t)(3 * NUM_INTERFACES), expected.size());
+    vector<vector<uint64_t>> expected_data;
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        // the parameters are released by the next scan
+        expected_data.push_back(vector<uint64_t>());
+        for (size_t j = 0; j < expected[i].num_of_parameters; j++)
+        {
+            expected_data[i].insert(expected_data[i].end(), expected[i].parameters[j].data, expected[i].parameters[j].data + expected[i].parameters[j].data_size / 8);
+        }
+    }
+    size_t missing_word = sizeof(mem_block) / 8 - 2;
+    mem_block[missing_word] = 0x5a5a5a5a5a5a5a5aULL;
+
+    FILE *file = fopen(raw_path.c_str(), "wb");
+    ASSERT_NE((FILE *)NULL, file);
+    ASSERT_EQ(sizeof(mem_block), fwrite(mem_block, 1, sizeof(mem_block), file));
+    fclose(file);
+
+    // the dump lists the words from the end, with one missing, to check the image is placed by address
+    file = fopen(text_path.c_str(), "w");
+    ASSERT_NE((FILE *)NULL, file);
+    fprintf(file, "Dumping DFL ROM Content...\n");
+    for (size_t i = sizeof(mem_block) / 8; i-- > 0;)
+    {
+        if (i != missing_word)
+        {
+            fprintf(file, "0x%lX 64 bit data is: 0x%lX \n", (uint64_t)&mem_block[i], mem_block[i]);
+        }
+    }
+    fclose(file);
+
+    const char *paths[] = { raw_path.c_str(), text_path.c_str() };
+    for (size_t k = 0; k < 2; k++)
+    {
+        const char *path = paths[k];
+        ASSERT_EQ((int)expected.size(), common_dfl_image_scan(path, DFL_IMAGE_AUTO, base_address)) << path;
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+            EXPECT_EQ(expected[i].guid.guid_l, info->guid.guid_l) << path << " differ at index " << i;
+            EXPECT_EQ(expected[i].guid.guid_h, info->guid.guid_h) << path << " differ at index " << i;
+            EXPECT_EQ(dfl_base_addr_offset_decoder((uint64_t)expected[i].base_address) + base_address, common_dfl_image_base_addr_decoder((uint64_t)info->base_address)) << path << " differ at index " << i;
+            EXPECT_EQ(expected[i].dfh_parent, info->dfh_parent) << path << " differ at index " << i;
+            EXPECT_EQ(expected[i].instance_id, info->instance_id) << path << " differ at index " << i;
+            EXPECT_EQ(expected[i].group_id, info->group_id) << path << " differ at index " << i;
+            ASSERT_EQ(expected[i].num_of_parameters, info->num_of_parameters) << path << " differ at index " << i;
+            vector<uint64_t> data;
+            for (size_t j = 0; j < info->num_of_parameters; j++)
+            {
+                data.insert(data.end(), info->parameters[j].data, info->parameters[j].data + info->parameters[j].data_size / 8);
+            }
+            EXPECT_EQ(expected_data[i], data) << path << " differ at index " << i;
+        }
+        EXPECT_EQ(sizeof(mem_block) - dfl_base_addr_offset_decoder((uint64_t)expected[0].base_address), common_fpga_interface_info_vec_at(0)->address_span) << path;
+        uint64_t *image = (uint64_t *)common_fpga_interface_info_vec_at(0)->dfh_address;
+        EXPECT_EQ(k == 0 ? mem_block[missing_word] : 0ULL, image[missing_word]) << path;
+    }
+
+    common_dfl_image_unload();
+    EXPECT_EQ((size_t)0, common_fpga_interface_info_vec_size());
+    EXPECT_EQ(-1, common_dfl_image_scan(raw_path.c_str(), DFL_IMAGE_TEXT, 0));
+    EXPECT_EQ(-1, common_dfl_image_scan(NULL, DFL_IMAGE_AUTO, 0));
+
+    unlink(raw_path.c_str());
+    unlink(text_path.c_str());
+}
+
+TEST_F(scan_hier_dfl, should_find_interfaces_by_guid)
+{
+    link_l1_l2.absolute_0 = true;
+    link_l1_l2.absolute_0_interface_index = 0;
+    link_l1_l2.absolute_0_param_index = 0;
+
+    link_l1_l2.absolute_1 = true;
+    link_l1_l2.absolute_1_interface_index = 1;
+    link_l1_l2.absolute_1_param_index = 1;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    size_t num_interfaces = common_fpga_interface_info_vec_size();
+    ASSERT_EQ((size_t)15, num_interfaces);
+
+    // the index must agree with a linear search of the interfaces
+    for (size_t i = 0; i < num_interfaces; i++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+        vector<unsigned int> expected;
+        int expected_first = -1;
+        for (size_t j = 0; j < num_interfaces; j++)
+        {
+            FPGA_INTERFACE_INFO *other = common_fpga_interface_info_vec_at(j);
+            if (other->guid.guid_l == info->guid.guid_l && other->guid.guid_h == info->guid.guid_h)
+            {
+                expected.push_back((unsigned int)j);
+                if (expected_first < 0 && other->instance_id == info->instance_id)
+                {
+                    expected_first = (int)j;
+                }
+            }
+        }
+
+        EXPECT_EQ(expected_first, fpga_find_interface(&info->guid, info->instance_id)) << "at i = " << i;
+        vector<unsigned int> indices(num_interfaces);
+        ASSERT_EQ((unsigned int)expected.size(), fpga_find_all_by_guid(&info->guid, indices.data(), (unsigned int)indices.size())) << "at i = " << i;
+        indices.resize(expected.size());
+        EXPECT_EQ(expected, indices) << "at i = " << i;
+    }
+
+    // the two bridges share a GUID
+    FPGA_INTERFACE_GUID bridge_guid = {0xaefb15b4b5e28284, 0x30c45aea68f642e6};
+    unsigned int first_bridge;
+    EXPECT_EQ((unsigned int)2, fpga_find_all_by_guid(&bridge_guid, NULL, 0));
+    EXPECT_EQ((unsigned int)2, fpga_find_all_by_guid(&bridge_guid, &first_bridge, 1));
+    EXPECT_EQ((unsigned int)0, first_bridge);
+
+    FPGA_INTERFACE_GUID unknown_guid = {0x1234, 0x5678};
+    EXPECT_EQ(-1, fpga_find_interface(&unknown_guid, 0));
+    EXPECT_EQ((unsigned int)0, fpga_find_all_by_guid(&unknown_guid, NULL, 0));
+    EXPECT_EQ(-1, fpga_find_interface(NULL, 0));
+
+    // an interface appended after the scan is still found
+    common_fpga_interface_info_vec_resize(num_interfaces + 1);
+    common_fpga_interface_info_vec_at(num_interfaces)->guid = unknown_guid;
+    EXPECT_EQ((int)num_interfaces, fpga_find_interface(&unknown_guid, 0));
+    EXPECT_EQ((unsigned int)3, fpga_find_all_by_guid(&bridge_guid, NULL, 0) + fpga_find_all_by_guid(&unknown_guid, NULL, 0));
+
+    common_fpga_interface_info_vec_resize(0);
+    EXPECT_EQ(-1, fpga_find_interface(&bridge_guid, 0));
+}
+
+// children, groups and depth-first order against a linear pass over dfh_parent and group_id
+TEST_F(scan_hier_dfl, should_navigate_the_interface_tree)
+{
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    link_l2_l3.relative_0 = true;
+    link_l2_l3.relative_0_interface_index = 1;
+    link_l2_l3.relative_0_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    int num_interfaces = (int)common_fpga_interface_info_vec_size();
+    ASSERT_EQ(3 * NUM_INTERFACES, num_interfaces);
+
+    unsigned int indices[3 * NUM_INTERFACES];
+    for (int i = 0; i < num_interfaces; i++)
+    {
+        vector<unsigned int> expected_children;
+        vector<unsigned int> expected_members;
+        for (int j = 0; j < num_interfaces; j++)
+        {
+            if (common_fpga_interface_info_vec_at(j)->dfh_parent == i)
+            {
+                expected_children.push_back(j);
+            }
+            if (common_fpga_interface_info_vec_at(j)->group_id == common_fpga_interface_info_vec_at(i)->group_id)
+            {
+                expected_members.push_back(j);
+            }
+        }
+        unsigned int count = fpga_get_children(i, indices, 3 * NUM_INTERFACES);
+        EXPECT_EQ(expected_children, vector<unsigned int>(indices, indices + count)) << "at i = " << i;
+        count = fpga_get_group_members(common_fpga_interface_info_vec_at(i)->group_id, indices, 3 * NUM_INTERFACES);
+        EXPECT_EQ(expected_members, vector<unsigned int>(indices, indices + count)) << "at i = " << i;
+    }
+    EXPECT_EQ((unsigned int)NUM_INTERFACES, fpga_get_children(0, NULL, 0));
+    EXPECT_EQ(0u, fpga_get_children(num_interfaces, indices, 3 * NUM_INTERFACES));
+
+    // the scan numbers the interfaces depth-first, so the walk visits them in index order
+    int expected = 0;
+    for (int i = fpga_get_next_in_tree(-1, -1); i >= 0; i = fpga_get_next_in_tree(-1, i))
+    {
+        EXPECT_EQ(expected++, i);
+    }
+    EXPECT_EQ(num_interfaces, expected);
+
+    // the subtree of the level two interface branching to level three holds level three only
+    int root = common_fpga_interface_info_vec_at(NUM_INTERFACES + 2)->dfh_parent;
+    expected = root;
+    for (int i = fpga_get_next_in_tree(root, -1); i >= 0; i = fpga_get_next_in_tree(root, i))
+    {
+        EXPECT_EQ(expected++, i);
+    }
+    EXPECT_EQ(root + NUM_INTERFACES + 1, expected);
+    EXPECT_EQ(-1, fpga_get_next_in_tree(num_interfaces, -1));
+}
+
+// l1 -> l2 -> l1; the branch back to level one is a cycle
+TEST_F(scan_hier_dfl, should_stop_at_a_cycle_between_levels)
+{
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    link_l2_l1.relative = true;
+    link_l2_l1.relative_interface_index = 0;
+    link_l2_l1.relative_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    EXPECT_EQ((size_t)(2 * NUM_INTERFACES), common_fpga_interface_info_vec_size());
+}
+
+// l1 -> l2 -> l3, bounded by the depth, the interface count and the address range
+TEST_F(scan_hier_dfl, should_deal_with_scan_limits)
+{
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    link_l2_l3.relative_0 = true;
+    link_l2_l3.relative_0_interface_index = 0;
+    link_l2_l3.relative_0_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    EXPECT_EQ((size_t)(3 * NUM_INTERFACES), common_fpga_interface_info_vec_size());
+
+    common_dfl_set_scan_limits(1, 0);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    EXPECT_EQ((size_t)(2 * NUM_INTERFACES), common_fpga_interface_info_vec_size());
+
+    common_dfl_set_scan_limits(0, 3);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)3, common_fpga_interface_info_vec_size());
+    EXPECT_EQ(-1, common_fpga_interface_info_vec_at(0)->dfh_parent);
+    EXPECT_EQ(0, common_fpga_interface_info_vec_at(1)->dfh_parent);
+    EXPECT_EQ(1, common_fpga_interface_info_vec_at(2)->dfh_parent);
+
+    // level one only
+    common_dfl_set_scan_limits(0, 0);
+    common_dfl_set_address_range(mem_block, NUM_INTERFACES * sizeof(HIER_DFL_BLOCK));
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    EXPECT_EQ((size_t)NUM_INTERFACES, common_fpga_interface_info_vec_size());
+
+    common_dfl_set_address_range(NULL, 0);
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    EXPECT_EQ((size_t)(3 * NUM_INTERFACES), common_fpga_interface_info_vec_size());
+}
+
+// level one and the l2 -> l3 DFL walked on two threads, each with its own context, then merged
+TEST_F(scan_hier_dfl, should_merge_dfls_scanned_concurrently)
+{
+    link_l2_l3.relative_0 = true;
+    link_l2_l3.relative_0_interface_index = 0;
+    link_l2_l3.relative_0_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    void *level_two = (uint8_t *)mem_block + NUM_INTERFACES * sizeof(HIER_DFL_BLOCK);
+
+    FPGA_DFL_SCAN_CTX ctx[2];
+    common_dfl_scan_ctx_init(&ctx[0]);
+    common_dfl_scan_ctx_init(&ctx[1]);
+    ctx[0].range_begin = (uint8_t *)mem_block;
+    ctx[0].range_size = NUM_INTERFACES * sizeof(HIER_DFL_BLOCK);
+
+    std::thread walker_one(common_dfl_scan_ctx_walk, &ctx[0], (void *)mem_block);
+    std::thread walker_two(common_dfl_scan_ctx_walk, &ctx[1], level_two);
+    walker_one.join();
+    walker_two.join();
+    EXPECT_EQ((size_t)NUM_INTERFACES, ctx[0].num_interfaces);
+    EXPECT_EQ((size_t)(2 * NUM_INTERFACES), ctx[1].num_interfaces);
+
+    common_fpga_interface_info_vec_resize(0);
+    EXPECT_EQ((FPGA_INTERFACE_INDEX)0, common_dfl_scan_ctx_merge(&ctx[0]));
+    EXPECT_EQ((FPGA_INTERFACE_INDEX)NUM_INTERFACES, common_dfl_scan_ctx_merge(&ctx[1]));
+    common_index_build();
+    common_dfl_scan_ctx_cleanup(&ctx[0]);
+    common_dfl_scan_ctx_cleanup(&ctx[1]);
+
+    ASSERT_EQ((size_t)(3 * NUM_INTERFACES), common_fpga_interface_info_vec_size());
+    EXPECT_EQ(level_two, common_fpga_interface_info_vec_at(NUM_INTERFACES)->dfh_address);
+    EXPECT_EQ(-1, common_fpga_interface_info_vec_at(NUM_INTERFACES)->dfh_parent);
+    EXPECT_EQ(NUM_INTERFACES, common_fpga_interface_info_vec_at(NUM_INTERFACES + 1)->dfh_parent);
+    EXPECT_NE(nullptr, common_fpga_interface_info_vec_at(NUM_INTERFACES + 1)->parameters);
+    EXPECT_EQ(NUM_INTERFACES + 1, fpga_find_interface(&common_fpga_interface_info_vec_at(NUM_INTERFACES + 1)->guid, common_fpga_interface_info_vec_at(NUM_INTERFACES + 1)->instance_id));
+}
+
+// two branches from l1 to l2 and from l2 to l3; the parallel walk numbers the interfaces as the serial one
+TEST_F(scan_hier_dfl, should_scan_branches_in_parallel_in_serial_order)
+{
+    link_l1_l2.absolute_0 = true;
+    link_l1_l2.absolute_0_interface_index = 0;
+    link_l1_l2.absolute_0_param_index = 0;
+
+    link_l1_l2.absolute_1 = true;
+    link_l1_l2.absolute_1_interface_index = 1;
+    link_l1_l2.absolute_1_param_index = 1;
+
+    link_l2_l3.absolute_0 = true;
+    link_l2_l3.absolute_0_interface_index = 1;
+    link_l2_l3.absolute_0_param_index = 1;
+
+    link_l2_l3.absolute_1 = true;
+    link_l2_l3.absolute_1_interface_index = 2;
+    link_l2_l3.absolute_1_param_index = 2;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+
+    for (size_t max_interfaces : {0, 12})
+    {
+        common_dfl_set_scan_limits(0, max_interfaces);
+        common_dfl_set_scan_workers(0);
+        common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+        vector<FPGA_INTERFACE_INFO> serial(g_common_fpga_interface_info_vec, g_common_fpga_interface_info_vec + common_fpga_interface_info_vec_size());
+        vector<uint64_t> serial_data;
+        for (const FPGA_INTERFACE_INFO &info : serial)
+        {
+            serial_data.insert(serial_data.end(), info.parameters[0].data, info.parameters[0].data + info.parameters[0].data_size / sizeof(uint64_t));
+        }
+
+        common_dfl_set_scan_workers(4);
+        common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+        ASSERT_EQ(serial.size(), common_fpga_interface_info_vec_size());
+        EXPECT_EQ(max_interfaces > 0 ? max_interfaces : (size_t)35, serial.size());
+        vector<uint64_t> parallel_data;
+        for (size_t i = 0; i < serial.size(); i++)
+        {
+            FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+            EXPECT_EQ(serial[i].dfh_address, info->dfh_address) << "interface " << i;
+            EXPECT_EQ(serial[i].dfh_parent, info->dfh_parent) << "interface " << i;
+            EXPECT_EQ(serial[i].num_of_parameters, info->num_of_parameters) << "interface " << i;
+            parallel_data.insert(parallel_data.end(), info->parameters[0].data, info->parameters[0].data + info->parameters[0].data_size / sizeof(uint64_t));
+        }
+        EXPECT_EQ(serial_data, parallel_data);
+    }
+
+    common_dfl_set_scan_workers(0);
+    common_dfl_set_scan_limits(0, 0);
+}
+
+static void rescan_callback(FPGA_DFL_RESCAN_EVENT event, unsigned int index, void *context)
+{
+    ((std::vector<std::pair<FPGA_DFL_RESCAN_EVENT, unsigned int>> *)context)->push_back(std::make_pair(event, index));
+}
+
+// l1 -> l2, level two changed behind interface 0 of level one
+TEST_F(scan_hier_dfl, should_rescan_a_subtree)
+{
+    link_l1_l2.relative_0 = true;
+    link_l1_l2.relative_0_interface_index = 0;
+    link_l1_l2.relative_0_param_index = 0;
+
+    create_hier_dfl(mem_block, NUM_INTERFACES);
+    HIER_DFL_BLOCK *level_two = (HIER_DFL_BLOCK *)mem_block + NUM_INTERFACES;
+    common_dfl_scan_multi_interfaces(mem_block, dfl_base_addr_decoder_mock);
+    ASSERT_EQ((size_t)(2 * NUM_INTERFACES), common_fpga_interface_info_vec_size());
+
+    // a rescan that finds nothing new does not keep the memory of its walk
+    std::vector<std::pair<FPGA_DFL_RESCAN_EVENT, unsigned int>> events;
+    size_t footprint = common_arena_footprint();
+    EXPECT_EQ(0, fpga_dfl_rescan(0, rescan_callback, &events));
+    EXPECT_EQ((size_t)0, events.size());
+    EXPECT_EQ(footprint, common_arena_footprint());
+
+    // interface 3 of level two is index 4; level one past interface 0 is not part of the subtree
+    level_two[3].x_feature_guid_l ^= 1;
+    EXPECT_EQ(1, fpga_dfl_rescan(0, rescan_callback, &events));
+    ASSERT_EQ((size_t)1, events.size());
+    EXPECT_EQ(std::make_pair(FPGA_DFL_RESCAN_CHANGED, 4u), events[0]);
+    EXPECT_EQ(level_two[3].x_feature_guid_l, common_fpga_interface_info_vec_at(4)->guid.guid_l);
+
+    // level two ends at interface 1: indices 3 to 5 are removed but keep their place
+    uint64_t dfh = level_two[1].x_feature_dfh;
+    level_two[1].x_feature_dfh |= 0x0000010000000000;
+    events.clear();
+    EXPECT_EQ(3, fpga_dfl_rescan(0, rescan_callback, &events));
+    ASSERT_EQ((size_t)3, events.size());
+    EXPECT_EQ(std::make_pair(FPGA_DFL_RESCAN_REMOVED, 3u), events[0]);
+    EXPECT_EQ(std::make_pair(FPGA_DFL_RESCAN_REMOVED, 5u), events[2]);
+    EXPECT_EQ((size_t)(2 * NUM_INTERFACES), common_fpga_interface_info_vec_size());
+    EXPECT_TRUE(common_fpga_interface_info_vec_at(4)->is_removed);
+    FPGA_INTERFACE_INFO info;
+    EXPECT_FALSE(fpga_get_interface_at(4, &info));
+    EXPECT_TRUE(fpga_get_interface_at(6, &info));
+    EXPECT_EQ(-1, fpga_dfl_rescan(4, NULL, NULL));
+
+    // level two is restored: the interfaces found again are appended
+    level_two[1].x_feature_dfh = dfh;
+    events.clear();
+    EXPECT_EQ(3, fpga_dfl_rescan(0, rescan_callback, &events));
+    ASSERT_EQ((size_t)(2 * NUM_INTERFACES + 3), common_fpga_interface_info_vec_size());
+    ASSERT_EQ((size_t)3, events.size());
+    EXPECT_EQ(std::make_pair(FPGA_DFL_RESCAN_ADDED, (unsigned int)(2 * NUM_INTERFACES)), events[0]);
+    for (size_t i = 2 * NUM_INTERFACES; i < common_fpga_interface_info_vec_size(); i++)
+    {
+        EXPECT_EQ(0, common_fpga_interface_info_vec_at(i)->dfh_parent) << "at i = " << i;
+    }
+    EXPECT_EQ(level_two[3].x_feature_guid_l, common_fpga_interface_info_vec_at(2 * NUM_INTERFACES + 1)->guid.guid_l);
+    EXPECT_TRUE(common_fpga_interface_info_vec_at(4)->is_removed);
+}
+
 // one branch from l1 -> l2; two branch from l2 -> l3; absolute; first and second param
 TEST_F(scan_hier_dfl, should_deal_with_one_branches_from_l1_to_l2_two_branch_from_l2_l3_absolute_address)
 {
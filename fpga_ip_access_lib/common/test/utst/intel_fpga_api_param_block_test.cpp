@@ -34,6 +34,7 @@ using namespace std;
 
 #include "intel_fpga_api_cmn_inf.h"
 #include "intel_fpga_api_cmn_dfl.h"
+#include "intel_fpga_api_cmn_arena.h"
 
 #define NEXT_PARAM_OFFSET_ADJUSTER 8
 
@@ -350,3 +351,115 @@ TEST_F(scan_single_dfh_param_block, should_deal_with_two_interfaces)
         EXPECT_EQ(0, (int)common_fpga_interface_info_vec_at(i)->parameters[NUM_PARAM_BLOCKS-1].data_size);
     }
 }
+
+TEST_F(scan_single_dfh_param_block, should_keep_parameters_of_an_interface_contiguous_in_the_arena)
+{
+    size_t num_interface = 2;
+    INTERFACE DFL[num_interface];
+    create_single_dfl(DFL, num_interface);
+
+    common_dfl_scan_multi_interfaces(&DFL[0], dfl_base_addr_decoder_mock);
+    ASSERT_EQ(num_interface, common_fpga_interface_info_vec_size());
+    EXPECT_GT(common_arena_footprint(), (size_t)0);
+
+    for (int i = 0; i < (int)num_interface; i++)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(i);
+        uint64_t *data = (uint64_t *)(info->parameters + info->num_of_parameters);
+        for (int j = 0; j < NUM_PARAM_BLOCKS - 1; j++)
+        {
+            EXPECT_EQ(data, info->parameters[j].data) << "parameter data not contiguous at i = " << i << ", j = " << j;
+            data += info->parameters[j].data_size / sizeof(uint64_t);
+        }
+        EXPECT_EQ(nullptr, info->parameters[NUM_PARAM_BLOCKS-1].data);
+    }
+
+    common_fpga_interface_info_vec_resize(0);
+    EXPECT_EQ((size_t)0, common_arena_footprint());
+}
+
+TEST_F(scan_single_dfh_param_block, should_get_parameter_by_param_id)
+{
+    size_t num_interface = 2;
+    INTERFACE DFL[num_interface];
+    create_single_dfl(DFL, num_interface);
+
+    common_dfl_scan_multi_interfaces(&DFL[0], dfl_base_addr_decoder_mock);
+    ASSERT_EQ(num_interface, common_fpga_interface_info_vec_size());
+
+    for (int i = 0; i < (int)num_interface; i++)
+    {
+        for (int j = 0; j < NUM_PARAM_BLOCKS - 1; j++)
+        {
+            EXPECT_EQ(&common_fpga_interface_info_vec_at(i)->parameters[j], fpga_get_parameter(i, j + 1, 0)) << "at i = " << i << ", j = " << j;
+            EXPECT_EQ(&common_fpga_interface_info_vec_at(i)->parameters[j], fpga_get_parameter(i, j + 1, j + 1)) << "at i = " << i << ", j = " << j;
+            EXPECT_EQ(nullptr, fpga_get_parameter(i, j + 1, j + 2)) << "at i = " << i << ", j = " << j;
+        }
+        EXPECT_EQ(nullptr, fpga_get_parameter(i, 0x7ff, 0));
+    }
+    EXPECT_EQ(nullptr, fpga_get_parameter(num_interface, 1, 0));
+}
+
+// the MMIO access parameter has no allocated ID, so it is only read when its ID is given
+TEST_F(scan_single_dfh_param_block, should_read_the_mmio_access_parameter_only_when_its_id_is_given)
+{
+    size_t num_interface = 2;
+    INTERFACE DFL[num_interface];
+    create_single_dfl(DFL, num_interface);
+    DFL[0].x_param_y_2[0] = (char)DFL_PARAM_MMIO_ACCESS_EMULATE_64BIT;
+
+    common_dfl_scan_multi_interfaces(&DFL[0], dfl_base_addr_decoder_mock);
+    ASSERT_EQ(num_interface, common_fpga_interface_info_vec_size());
+    EXPECT_FALSE(common_fpga_interface_info_vec_at(0)->emulate_64bit);
+    EXPECT_FALSE(common_fpga_interface_info_vec_at(1)->emulate_64bit);
+
+    common_dfl_set_mmio_access_param_id(2);
+    common_dfl_scan_multi_interfaces(&DFL[0], dfl_base_addr_decoder_mock);
+    EXPECT_TRUE(common_fpga_interface_info_vec_at(0)->emulate_64bit);
+    EXPECT_FALSE(common_fpga_interface_info_vec_at(1)->emulate_64bit);
+
+    // the parameter overrides the default of its interface
+    common_dfl_set_64bit_emulation(true);
+    common_dfl_scan_multi_interfaces(&DFL[0], dfl_base_addr_decoder_mock);
+    EXPECT_TRUE(common_fpga_interface_info_vec_at(0)->emulate_64bit);
+    EXPECT_FALSE(common_fpga_interface_info_vec_at(1)->emulate_64bit);
+
+    common_dfl_set_mmio_access_param_id(0);
+    common_dfl_scan_multi_interfaces(&DFL[0], dfl_base_addr_decoder_mock);
+    EXPECT_TRUE(common_fpga_interface_info_vec_at(0)->emulate_64bit);
+    EXPECT_TRUE(common_fpga_interface_info_vec_at(1)->emulate_64bit);
+    common_dfl_set_64bit_emulation(false);
+}
+
+TEST_F(scan_single_dfh_param_block, should_get_highest_version_of_repeated_param_id)
+{
+    const uint16_t param_ids[] = {5, 3, 5, 3, 1};
+    const uint16_t versions[] = {1, 2, 3, 2, 0};
+    size_t num_params = sizeof(param_ids) / sizeof(param_ids[0]);
+
+    common_fpga_interface_info_vec_resize(0);
+    common_fpga_interface_info_vec_resize(1);
+    FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(0);
+    info->parameters = (FPGA_INTERFACE_PARAMETER *)common_arena_alloc(num_params * sizeof(FPGA_INTERFACE_PARAMETER));
+    info->num_of_parameters = num_params;
+    for (size_t i = 0; i < num_params; i++)
+    {
+        info->parameters[i].param_id = param_ids[i];
+        info->parameters[i].version = versions[i];
+    }
+
+    // without the sorted order the parameters are searched linearly, with the same result
+    for (int pass = 0; pass < 2; pass++)
+    {
+        EXPECT_EQ(&info->parameters[2], fpga_get_parameter(0, 5, 0)) << "pass " << pass;
+        EXPECT_EQ(&info->parameters[2], fpga_get_parameter(0, 5, 3)) << "pass " << pass;
+        EXPECT_EQ(nullptr, fpga_get_parameter(0, 5, 4)) << "pass " << pass;
+        EXPECT_EQ(&info->parameters[1], fpga_get_parameter(0, 3, 1)) << "pass " << pass;
+        EXPECT_EQ(&info->parameters[4], fpga_get_parameter(0, 1, 0)) << "pass " << pass;
+        EXPECT_EQ(nullptr, fpga_get_parameter(0, 2, 0)) << "pass " << pass;
+        EXPECT_EQ(nullptr, fpga_get_parameter(0, 6, 0)) << "pass " << pass;
+        common_dfl_param_order_build(info, NULL);
+    }
+
+    common_fpga_interface_info_vec_resize(0);
+}
@@ -28,5 +28,6 @@
 
 #include "intel_fpga_api_cmn_msg.h"
 #include "intel_fpga_api_cmn_inf.h"
+#include "intel_fpga_api_cmn_shadow.h"
 #include "intel_fpga_api_devmem.h"
 
@@ -26,9 +26,53 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
 
 #include "intel_fpga_api_devmem.h"
 #include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_arch.h"
+
+// Busy-wait window before FPGA_POLL_BACKOFF and FPGA_POLL_SLEEP start to back off, and the back-off limits
+#define FPGA_POLL_SPIN_WINDOW_NS    2000
+#define FPGA_POLL_MAX_RELAX_COUNT   1024
+#define FPGA_POLL_MAX_SLEEP_NS      1000000
+
+static uint64_t devmem_poll_now_ns();
+static uint64_t devmem_poll_read(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t width);
+
+uint64_t devmem_poll_now_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t devmem_poll_read(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t width)
+{
+    uint64_t ret;
+
+    switch (width)
+    {
+        case 8:
+            ret = fpga_read_8(handle, offset);
+            break;
+        case 16:
+            ret = fpga_read_16(handle, offset);
+            break;
+        case 32:
+            ret = fpga_read_32(handle, offset);
+            break;
+        default:
+            ret = fpga_read_64(handle, offset);
+            break;
+    }
+
+    return ret;
+}
 
 void *fpga_malloc(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t size)
 {
@@ -49,6 +93,336 @@ FPGA_PLATFORM_PHYSICAL_MEM_ADDR_TYPE fpga_get_physical_address(void *address)
     return 0;
 }
 
+int fpga_mmio_batch(FPGA_MMIO_INTERFACE_HANDLE handle, const FPGA_MMIO_BATCH_DESC *desc, size_t count)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        // Resolve the interface once for the whole list, and order it after the prior memory stores.
+        volatile uint8_t *base = (volatile uint8_t *)fpga_devmem_get_base_address(handle);
+        bool emulate_64bit = fpga_devmem_is_64bit_emulated(handle);
+        size_t i;
+
+        common_mmio_before_write();
+        for (i = 0; i < count; ++i)
+        {
+            volatile uint8_t *addr = base + desc[i].offset;
+
+            if (desc[i].op == FPGA_MMIO_BATCH_WRITE)
+            {
+                switch (desc[i].width)
+                {
+                    case 8:
+                        *addr = (uint8_t)desc[i].value;
+                        break;
+                    case 16:
+                        *((volatile uint16_t *)addr) = (uint16_t)desc[i].value;
+                        break;
+                    case 32:
+                        *((volatile uint32_t *)addr) = (uint32_t)desc[i].value;
+                        break;
+                    case 64:
+                        if (!emulate_64bit)
+                        {
+                            *((volatile uint64_t *)addr) = desc[i].value;
+                        }
+                        else
+                        {
+                            *((volatile uint32_t *)addr) = (uint32_t)desc[i].value;
+                            *((volatile uint32_t *)(addr + 4)) = (uint32_t)(desc[i].value >> 32);
+                        }
+                        break;
+                    default:
+                        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid access width %u in batch entry %zu.", desc[i].width, i);
+                        return -1;
+                }
+            }
+            else if (desc[i].op == FPGA_MMIO_BATCH_READ)
+            {
+                switch (desc[i].width)
+                {
+                    case 8:
+                        *((uint8_t *)desc[i].ptr) = *addr;
+                        break;
+                    case 16:
+                        *((uint16_t *)desc[i].ptr) = *((volatile uint16_t *)addr);
+                        break;
+                    case 32:
+                        *((uint32_t *)desc[i].ptr) = *((volatile uint32_t *)addr);
+                        break;
+                    case 64:
+                        if (!emulate_64bit)
+                        {
+                            *((uint64_t *)desc[i].ptr) = *((volatile uint64_t *)addr);
+                        }
+                        else
+                        {
+                            *((uint64_t *)desc[i].ptr) = *((volatile uint32_t *)addr) | ((uint64_t)*((volatile uint32_t *)(addr + 4)) << 32);
+                        }
+                        break;
+                    default:
+                        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid access width %u in batch entry %zu.", desc[i].width, i);
+                        return -1;
+                }
+            }
+            else
+            {
+                fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid operation %d in batch entry %zu.", desc[i].op, i);
+                return -1;
+            }
+        }
+
+        // Only one barrier for the whole list; the accesses above are relaxed.
+        common_mmio_mb();
+        ret = 0;
+    }
+
+    return ret;
+}
+
+FPGA_MMIO_FAST_HANDLE fpga_open_fast(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    FPGA_MMIO_FAST_HANDLE ret = { NULL, 0, 0 };
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() &&
+        common_fpga_interface_info_vec_at(handle)->is_mmio_opened)
+    {
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(handle);
+
+        ret.base = (volatile uint8_t *)info->base_address;
+        ret.span = info->address_span;
+        ret.flags = info->write_combining ? FPGA_MMIO_FAST_HANDLE_WRITE_COMBINING : 0;
+        ret.flags |= fpga_devmem_is_64bit_emulated(handle) ? FPGA_MMIO_FAST_HANDLE_EMULATE_64BIT : 0;
+    }
+    return ret;
+}
+
+int fpga_read_block(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, void *dst, size_t len)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        volatile uint8_t *base = (volatile uint8_t *)fpga_devmem_get_base_address(handle);
+        bool emulate_64bit = fpga_devmem_is_64bit_emulated(handle);
+        uint8_t *data = (uint8_t *)dst;
+        uint16_t data_16;
+        uint32_t data_32;
+        size_t n;
+
+        // Unaligned head: one access per size until the offset is 64-bit aligned or the buffer runs out.
+        if ((offset & 1) && len >= 1)
+        {
+            *data = base[offset];
+            offset += 1; data += 1; len -= 1;
+        }
+        if ((offset & 2) && len >= 2)
+        {
+            data_16 = *((volatile uint16_t *)(base + offset));
+            memcpy(data, &data_16, 2);
+            offset += 2; data += 2; len -= 2;
+        }
+        if ((offset & 4) && len >= 4)
+        {
+            data_32 = *((volatile uint32_t *)(base + offset));
+            memcpy(data, &data_32, 4);
+            offset += 4; data += 4; len -= 4;
+        }
+
+        if (!emulate_64bit)
+        {
+            n = len & ~(size_t)7;
+            common_mmio_copy_from_io(data, base + offset, n);
+        }
+        else
+        {
+            for (n = 0; n + 4 <= len; n += 4)
+            {
+                data_32 = *((volatile uint32_t *)(base + offset + n));
+                memcpy(data + n, &data_32, 4);
+            }
+        }
+        offset += n; data += n; len -= n;
+
+        // Tail
+        if (len & 4)
+        {
+            data_32 = *((volatile uint32_t *)(base + offset));
+            memcpy(data, &data_32, 4);
+            offset += 4; data += 4;
+        }
+        if (len & 2)
+        {
+            data_16 = *((volatile uint16_t *)(base + offset));
+            memcpy(data, &data_16, 2);
+            offset += 2; data += 2;
+        }
+        if (len & 1)
+        {
+            *data = base[offset];
+        }
+
+        ret = 0;
+    }
+
+    return ret;
+}
+
+int fpga_write_block(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, const void *src, size_t len)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        volatile uint8_t *base = (volatile uint8_t *)fpga_devmem_get_base_address(handle);
+        bool emulate_64bit = fpga_devmem_is_64bit_emulated(handle);
+        const uint8_t *data = (const uint8_t *)src;
+        uint16_t data_16;
+        uint32_t data_32;
+        size_t n;
+
+        // Unaligned head: one access per size until the offset is 64-bit aligned or the buffer runs out.
+        if ((offset & 1) && len >= 1)
+        {
+            base[offset] = *data;
+            offset += 1; data += 1; len -= 1;
+        }
+        if ((offset & 2) && len >= 2)
+        {
+            memcpy(&data_16, data, 2);
+            *((volatile uint16_t *)(base + offset)) = data_16;
+            offset += 2; data += 2; len -= 2;
+        }
+        if ((offset & 4) && len >= 4)
+        {
+            memcpy(&data_32, data, 4);
+            *((volatile uint32_t *)(base + offset)) = data_32;
+            offset += 4; data += 4; len -= 4;
+        }
+
+        if (!emulate_64bit)
+        {
+            n = len & ~(size_t)7;
+            common_mmio_copy_to_io(base + offset, data, n);
+        }
+        else
+        {
+            for (n = 0; n + 4 <= len; n += 4)
+            {
+                memcpy(&data_32, data + n, 4);
+                *((volatile uint32_t *)(base + offset + n)) = data_32;
+            }
+        }
+        offset += n; data += n; len -= n;
+
+        // Tail
+        if (len & 4)
+        {
+            memcpy(&data_32, data, 4);
+            *((volatile uint32_t *)(base + offset)) = data_32;
+            offset += 4; data += 4;
+        }
+        if (len & 2)
+        {
+            memcpy(&data_16, data, 2);
+            *((volatile uint16_t *)(base + offset)) = data_16;
+            offset += 2; data += 2;
+        }
+        if (len & 1)
+        {
+            base[offset] = *data;
+        }
+
+        ret = 0;
+    }
+
+    return ret;
+}
+
+int fpga_poll_until(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t width, uint64_t mask, uint64_t value,
+                    uint64_t timeout_ns, FPGA_POLL_POLICY policy, FPGA_POLL_RESULT *result)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        uint64_t start_ns;
+        uint64_t elapsed_ns;
+        uint64_t read_count = 0;
+        uint64_t data;
+        unsigned int relax_count = 1;
+        uint64_t sleep_ns = 1000;
+        unsigned int i;
+
+        if (width != 8 && width != 16 && width != 32 && width != 64)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid access width %u.", width);
+            return -1;
+        }
+        if (policy != FPGA_POLL_SPIN && policy != FPGA_POLL_BACKOFF && policy != FPGA_POLL_SLEEP)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid polling policy %d.", policy);
+            return -1;
+        }
+
+        start_ns = devmem_poll_now_ns();
+        for (;;)
+        {
+            data = devmem_poll_read(handle, offset, width);
+            ++read_count;
+            elapsed_ns = devmem_poll_now_ns() - start_ns;
+            if ((data & mask) == value)
+            {
+                ret = 0;
+                break;
+            }
+            if (elapsed_ns >= timeout_ns)
+            {
+                ret = 1;
+                break;
+            }
+
+            if (policy == FPGA_POLL_SPIN || elapsed_ns < FPGA_POLL_SPIN_WINDOW_NS)
+            {
+                common_cpu_relax();
+            }
+            else if (policy == FPGA_POLL_BACKOFF)
+            {
+                // Double the gap between reads; once it is capped, give the CPU away between reads as well.
+                for (i = 0; i < relax_count; ++i)
+                {
+                    common_cpu_relax();
+                }
+                if (relax_count < FPGA_POLL_MAX_RELAX_COUNT)
+                {
+                    relax_count <<= 1;
+                }
+                else
+                {
+                    sched_yield();
+                }
+            }
+            else
+            {
+                uint64_t remaining_ns = timeout_ns - elapsed_ns;
+                uint64_t ns = sleep_ns < remaining_ns ? sleep_ns : remaining_ns;
+                struct timespec ts = { (time_t)(ns / 1000000000), (long)(ns % 1000000000) };
+
+                nanosleep(&ts, NULL);
+                if (sleep_ns < FPGA_POLL_MAX_SLEEP_NS)
+                {
+                    sleep_ns <<= 1;
+                }
+            }
+        }
+
+        if (result != NULL)
+        {
+            result->elapsed_ns = elapsed_ns;
+            result->read_count = read_count;
+            result->value = data;
+        }
+    }
+
+    return ret;
+}
+
 int fpga_register_isr(FPGA_INTERRUPT_HANDLE handle, FPGA_ISR isr, void *isr_context)
 {
     fpga_throw_runtime_exception("fpga_register_isr", __FILE__, __LINE__, "Current platform doesn't support such feature.");
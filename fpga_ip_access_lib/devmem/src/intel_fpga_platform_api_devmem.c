@@ -42,6 +42,7 @@
 #include <pthread.h>
 #include <poll.h>
 #include <semaphore.h>
+#include <dirent.h>
 
 #include "intel_fpga_api_cmn_msg.h"
 #include "intel_fpga_api_devmem.h"
@@ -53,19 +54,49 @@ static char *s_devmem_drv_path = "/dev/mem";
 static size_t s_devmem_addr_span = 0;
 static size_t s_dfl_entry_addr = 0;
 static int s_devmem_single_component_mode = 1;
+static int s_devmem_emulate_64bit = 0;
+static bool s_devmem_dfl_rom_snapshot = false;
+static size_t s_devmem_dfl_rom_snapshot_size = 0;   // 0 bounds the snapshot by the DFH list
+static bool s_devmem_dfl_param_views = false;
+static char *s_devmem_dfl_cache_path = NULL;
+static size_t s_devmem_dfl_max_depth = 0;          // 0 keeps the default DFL scan limit
+static size_t s_devmem_dfl_max_interfaces = 0;
+static size_t s_devmem_dfl_scan_workers = 0;
+static size_t s_devmem_dfl_mmio_access_param_id = 0;
 static size_t s_devmem_start_addr = 0;
 
 static int s_devmem_drv_handle = -1;
 static void *s_devmem_mmap_ptr = NULL;
 static const uint64_t MASK_4K_ADDR = ~(4*1024-1);
 
+typedef struct
+{
+    size_t          offset;         // Region offset from the start address
+    size_t          size;
+    void            *mmap_ptr;      // Write-combined mapping, or best-effort /dev/mem mapping
+    size_t          mmap_size;
+    unsigned int    index;          // Index of the interface exposing the region
+} DEVMEM_WC_REGION;
+
+static DEVMEM_WC_REGION s_devmem_wc_regions[FPGA_PLATFORM_MAX_WC_REGIONS];
+static unsigned int s_devmem_wc_region_count = 0;
+static bool s_devmem_wc_args_valid = true;
+static int s_devmem_wc_drv_handle = -1;
+
 static void devmem_parse_args(unsigned int argc, const char *argv[]);
 static long devmem_parse_integer_arg(const char *name);
+static void devmem_parse_wc_region_arg();
 static bool devmem_validate_args();
 static void devmem_print_configuration();
 static bool devmem_open_driver();
 static bool devmem_map_mmio();
 static bool devmem_scan_interfaces();
+static void devmem_update_address_spans();
+static bool devmem_add_wc_interfaces();
+#ifndef DEVMEM_UNIT_TEST_SW_MODEL_MODE
+static bool devmem_get_sysfs_wc_resource_path(uint64_t addr, size_t size, char *path, int path_buf_size, size_t *bar_offset);
+#endif
+static void devmem_unmap_wc_regions();
 static bool devmem_create_unit_test_sw_model();
 
 bool fpga_platform_init(unsigned int argc, const char *argv[])
@@ -79,6 +110,13 @@ bool fpga_platform_init(unsigned int argc, const char *argv[])
     if (is_args_valid)
     {
         devmem_print_configuration();
+        common_dfl_set_64bit_emulation(s_devmem_emulate_64bit != 0);
+        common_dfl_set_rom_snapshot(s_devmem_dfl_rom_snapshot, s_devmem_dfl_rom_snapshot_size);
+        common_dfl_set_param_views(s_devmem_dfl_param_views);
+        common_dfl_set_cache_path(s_devmem_dfl_cache_path);
+        common_dfl_set_scan_limits(s_devmem_dfl_max_depth, s_devmem_dfl_max_interfaces);
+        common_dfl_set_scan_workers(s_devmem_dfl_scan_workers);
+        common_dfl_set_mmio_access_param_id((uint16_t)s_devmem_dfl_mmio_access_param_id);
 #ifndef DEVMEM_UNIT_TEST_SW_MODEL_MODE
         if (devmem_open_driver() == false)
             goto err_open;
@@ -88,9 +126,15 @@ bool fpga_platform_init(unsigned int argc, const char *argv[])
 
         if (devmem_scan_interfaces() == false)
             goto err_scan;
+
+        if (devmem_add_wc_interfaces() == false)
+            goto err_wc;
 #else
         if (devmem_create_unit_test_sw_model() == false)
             goto err_open;
+
+        if (devmem_add_wc_interfaces() == false)
+            goto err_wc;
 #endif
         ret = true;
     }
@@ -102,11 +146,19 @@ bool fpga_platform_init(unsigned int argc, const char *argv[])
     return ret;
 
 #ifndef DEVMEM_UNIT_TEST_SW_MODEL_MODE
+err_wc:
+    devmem_unmap_wc_regions();
+    common_fpga_interface_info_vec_resize(0);
+
 err_scan:
     munmap(s_devmem_mmap_ptr, s_devmem_addr_span);
 
 err_map:
     close(s_devmem_drv_handle);
+#else
+err_wc:
+    free(common_fpga_interface_info_vec_at(0)->base_address);
+    common_fpga_interface_info_vec_resize(0);
 #endif
 
 err_open:
@@ -119,6 +171,8 @@ void fpga_platform_cleanup()
     munmap(s_devmem_mmap_ptr, s_devmem_addr_span);
 #endif
 
+    devmem_unmap_wc_regions();
+
     if (s_devmem_drv_handle >= 0)
     {
         close(s_devmem_drv_handle);
@@ -128,6 +182,26 @@ void fpga_platform_cleanup()
     s_devmem_start_addr = 0;
     s_devmem_addr_span = 0;
     s_devmem_single_component_mode = 1;
+    s_devmem_wc_region_count = 0;
+    s_devmem_wc_args_valid = true;
+    s_devmem_emulate_64bit = 0;
+    common_dfl_set_64bit_emulation(false);
+    s_devmem_dfl_rom_snapshot = false;
+    s_devmem_dfl_rom_snapshot_size = 0;
+    common_dfl_set_rom_snapshot(false, 0);
+    s_devmem_dfl_param_views = false;
+    common_dfl_set_param_views(false);
+    s_devmem_dfl_cache_path = NULL;
+    common_dfl_set_cache_path(NULL);
+    s_devmem_dfl_max_depth = 0;
+    s_devmem_dfl_max_interfaces = 0;
+    common_dfl_set_scan_limits(0, 0);
+    s_devmem_dfl_scan_workers = 0;
+    common_dfl_set_scan_workers(0);
+    s_devmem_dfl_mmio_access_param_id = 0;
+    common_dfl_set_mmio_access_param_id(0);
+    common_dfl_set_address_range(NULL, 0);
+    common_dfl_set_base_addr_decoder(NULL);
 
     s_devmem_drv_handle = -1;
     s_devmem_mmap_ptr = NULL;
@@ -155,6 +229,15 @@ void devmem_parse_args(unsigned int argc, const char *argv[])
             {"dfl-entry-address", required_argument, 0, 'w'},
             {"show-dbg-msg", no_argument, &g_common_show_dbg_msg, 'd'},
             {"single-component-mode", no_argument, &s_devmem_single_component_mode, 'c'},
+            {"emulate-64bit", no_argument, &s_devmem_emulate_64bit, 'e'},
+            {"dfl-rom-snapshot", optional_argument, 0, 'n'},
+            {"dfl-param-views", no_argument, 0, 'v'},
+            {"dfl-cache", required_argument, 0, 'k'},
+            {"dfl-max-depth", required_argument, 0, 'l'},
+            {"dfl-max-interfaces", required_argument, 0, 'i'},
+            {"dfl-scan-workers", required_argument, 0, 't'},
+            {"dfl-mmio-access-param", required_argument, 0, 'm'},
+            {"wc-region", required_argument, 0, 'r'},
             {0, 0, 0, 0}};
 
     int option_index = 0;
@@ -165,7 +248,7 @@ void devmem_parse_args(unsigned int argc, const char *argv[])
 
     while (1)
     {
-        c = getopt_long(argc, (char *const *)argv, "p:a:w:s:dc", long_options, &option_index);
+        c = getopt_long(argc, (char *const *)argv, "p:a:w:s:dcr:en::vk:l:i:t:m:", long_options, &option_index);
 
         if (c == -1)
         {
@@ -190,6 +273,43 @@ void devmem_parse_args(unsigned int argc, const char *argv[])
             s_dfl_entry_addr = devmem_parse_integer_arg("DFL entry address");
             s_devmem_single_component_mode = false;
             break;
+
+        case 'r':
+            devmem_parse_wc_region_arg();
+            break;
+
+        case 'e':
+            s_devmem_emulate_64bit = 1;
+            break;
+
+        case 'n':
+            s_devmem_dfl_rom_snapshot = true;
+            s_devmem_dfl_rom_snapshot_size = optarg != NULL ? devmem_parse_integer_arg("DFL ROM snapshot size") : 0;
+            break;
+
+        case 'v':
+            s_devmem_dfl_param_views = true;
+            break;
+
+        case 'k':
+            s_devmem_dfl_cache_path = optarg;
+            break;
+
+        case 'l':
+            s_devmem_dfl_max_depth = devmem_parse_integer_arg("DFL max depth");
+            break;
+
+        case 'i':
+            s_devmem_dfl_max_interfaces = devmem_parse_integer_arg("DFL max interfaces");
+            break;
+
+        case 't':
+            s_devmem_dfl_scan_workers = devmem_parse_integer_arg("DFL scan workers");
+            break;
+
+        case 'm':
+            s_devmem_dfl_mmio_access_param_id = devmem_parse_integer_arg("DFL MMIO access parameter ID");
+            break;
         }
     }
 }
@@ -267,6 +387,44 @@ long devmem_parse_integer_arg(const char *name)
 }
 
 
+void devmem_parse_wc_region_arg()
+{
+    char *endptr;
+    size_t offset;
+    size_t size;
+
+    if (s_devmem_wc_region_count >= FPGA_PLATFORM_MAX_WC_REGIONS)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Too many write-combined regions. %s is ignored; maximum accepted is %d", optarg, FPGA_PLATFORM_MAX_WC_REGIONS);
+        s_devmem_wc_args_valid = false;
+        return;
+    }
+
+    // <offset>:<size>
+    errno = 0;
+    offset = strtoul(optarg, &endptr, 0);
+    if (endptr == optarg || *endptr != ':' || errno == ERANGE)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Invalid write-combined region. <offset>:<size> is expected. %s is provided.", optarg);
+        s_devmem_wc_args_valid = false;
+        return;
+    }
+
+    size = strtoul(endptr + 1, &endptr, 0);
+    if (*endptr != '\0' || size == 0 || errno == ERANGE)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Invalid write-combined region. <offset>:<size> is expected. %s is provided.", optarg);
+        s_devmem_wc_args_valid = false;
+        return;
+    }
+
+    s_devmem_wc_regions[s_devmem_wc_region_count].offset = offset;
+    s_devmem_wc_regions[s_devmem_wc_region_count].size = size;
+    s_devmem_wc_regions[s_devmem_wc_region_count].mmap_ptr = NULL;
+    s_devmem_wc_regions[s_devmem_wc_region_count].mmap_size = 0;
+    ++s_devmem_wc_region_count;
+}
+
 bool devmem_validate_args()
 {
     bool ret = s_devmem_addr_span > 0 &&
@@ -290,7 +448,22 @@ bool devmem_validate_args()
         ret = false;
     }
 
-    return ret;
+    for (unsigned int i = 0; i < s_devmem_wc_region_count; ++i)
+    {
+        if (s_devmem_wc_regions[i].offset >= s_devmem_addr_span || s_devmem_wc_regions[i].size > s_devmem_addr_span - s_devmem_wc_regions[i].offset)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Write-combined region 0x%lX:0x%lX is not within the range based on the argument --address-span.", s_devmem_wc_regions[i].offset, s_devmem_wc_regions[i].size);
+            ret = false;
+        }
+    }
+
+    if (s_devmem_dfl_mmio_access_param_id > UINT16_MAX)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "DFL MMIO access parameter ID 0x%lX is not a 16-bit parameter ID.", s_devmem_dfl_mmio_access_param_id);
+        ret = false;
+    }
+
+    return ret && s_devmem_wc_args_valid;
 }
 
 void devmem_print_configuration()
@@ -308,6 +481,46 @@ void devmem_print_configuration()
         fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Operation Model: Yes");
         fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Entry Address: 0x%lX", s_dfl_entry_addr);
     }
+    for (unsigned int i = 0; i < s_devmem_wc_region_count; ++i)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   Write-Combined Region: 0x%lX:0x%lX", s_devmem_wc_regions[i].offset, s_devmem_wc_regions[i].size);
+    }
+    if (s_devmem_emulate_64bit)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   64-bit Access Emulation: Yes");
+    }
+    if (s_devmem_dfl_rom_snapshot)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL ROM Snapshot: Yes");
+        if (s_devmem_dfl_rom_snapshot_size > 0)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL ROM Snapshot Size: %ld", s_devmem_dfl_rom_snapshot_size);
+        }
+    }
+    if (s_devmem_dfl_param_views)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Parameter Views: Yes");
+    }
+    if (s_devmem_dfl_cache_path != NULL)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Cache: %s", s_devmem_dfl_cache_path);
+    }
+    if (s_devmem_dfl_max_depth > 0)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Max Depth: %ld", s_devmem_dfl_max_depth);
+    }
+    if (s_devmem_dfl_max_interfaces > 0)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Max Interfaces: %ld", s_devmem_dfl_max_interfaces);
+    }
+    if (s_devmem_dfl_scan_workers > 1)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Scan Workers: %ld", s_devmem_dfl_scan_workers);
+    }
+    if (s_devmem_dfl_mmio_access_param_id > 0)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL MMIO Access Parameter ID: 0x%lX", s_devmem_dfl_mmio_access_param_id);
+    }
 }
 
 bool devmem_open_driver()
@@ -367,8 +580,11 @@ bool devmem_scan_interfaces()
         common_fpga_interface_info_vec_resize(1);
 
         common_fpga_interface_info_vec_at(0)->base_address = (void *)s_devmem_mmap_ptr + (s_devmem_start_addr & ~MASK_4K_ADDR);
+        common_fpga_interface_info_vec_at(0)->address_span = s_devmem_addr_span - (s_devmem_start_addr & ~MASK_4K_ADDR);
+        common_fpga_interface_info_vec_at(0)->emulate_64bit = s_devmem_emulate_64bit != 0;
         common_fpga_interface_info_vec_at(0)->is_mmio_opened = false;
         common_fpga_interface_info_vec_at(0)->is_interrupt_opened = false;
+        common_fpga_interface_hot_update(0);
     }
     else
     {
@@ -376,12 +592,236 @@ bool devmem_scan_interfaces()
 #ifdef DFL_WALKER_DEBUG_MODE
         fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Walking through multi-components mode with fisrt DFL address: 0x%lX", (size_t)first_dfh_addr);
 #endif
+        common_dfl_set_address_range(s_devmem_mmap_ptr, s_devmem_addr_span);
         common_dfl_scan_multi_interfaces(first_dfh_addr, devmem_dfl_base_addr_decoder);
+        devmem_update_address_spans();
+    }
+
+    return ret;
+}
+
+void devmem_update_address_spans()
+{
+    size_t i;
+    char *map_end = (char *)s_devmem_mmap_ptr + s_devmem_addr_span;
+
+    // Each interface may be accessed up to the end of the mapping; interfaces decoded outside of it get no span.
+    for (i = 0; i < common_fpga_interface_info_vec_size(); ++i)
+    {
+        char *base = (char *)common_fpga_interface_info_vec_at(i)->base_address;
+
+        common_fpga_interface_info_vec_at(i)->address_span = (base >= (char *)s_devmem_mmap_ptr && base < map_end) ? (size_t)(map_end - base) : 0;
+    }
+}
+
+bool devmem_add_wc_interfaces()
+{
+    bool ret = true;
+    unsigned int i;
+#ifndef DEVMEM_UNIT_TEST_SW_MODEL_MODE
+    enum
+    {
+        DEVMEM_WC_PATH_SIZE = 1024
+    };
+    char wc_path[DEVMEM_WC_PATH_SIZE + 1];
+    size_t uc_span = s_devmem_addr_span - (s_devmem_start_addr & ~MASK_4K_ADDR);
+
+    if (s_devmem_wc_region_count == 0)
+    {
+        return ret;
+    }
+
+    // Fallback for the regions outside of any PCI BAR with a write-combined resource file.  /dev/mem gives no control
+    // over the memory type: on x86 the PAT/MTRR type of the range applies, usually uncached for MMIO, and arm64 maps it
+    // as device memory, so such a region is write-combined on a best-effort basis only.
+    s_devmem_wc_drv_handle = open(s_devmem_drv_path, O_RDWR);
+    if (s_devmem_wc_drv_handle == -1)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Failed to open %s for write-combined regions. (Error code %d)", s_devmem_drv_path, errno);
+        return false;
+    }
+#else
+    size_t uc_span = s_devmem_addr_span;
+#endif
+
+    for (i = 0; i < s_devmem_wc_region_count; ++i)
+    {
+        DEVMEM_WC_REGION *region = &s_devmem_wc_regions[i];
+        void *base;
+        size_t index;
+
+        if (region->offset >= uc_span || region->size > uc_span - region->offset)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Write-combined region 0x%lX:0x%lX is outside of the mapped range of 0x%lX bytes.", region->offset, region->size, uc_span);
+            ret = false;
+            break;
+        }
+
+#ifndef DEVMEM_UNIT_TEST_SW_MODEL_MODE
+        size_t region_addr = s_devmem_start_addr + region->offset;
+        size_t file_offset = region_addr;
+        size_t bar_offset = 0;
+        int fd = s_devmem_wc_drv_handle;
+        int wc_fd = -1;
+
+        if (devmem_get_sysfs_wc_resource_path(region_addr, region->size, wc_path, DEVMEM_WC_PATH_SIZE, &bar_offset))
+        {
+            wc_fd = open(wc_path, O_RDWR);
+        }
+        if (wc_fd != -1)
+        {
+            fd = wc_fd;
+            file_offset = bar_offset;
+        }
+        else
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "No write-combined PCI resource holds the region 0x%lX:0x%lX; it is mapped through %s and may be uncached.", region->offset, region->size, s_devmem_drv_path);
+        }
+
+        region->mmap_size = region->size + (file_offset & ~MASK_4K_ADDR);
+        region->mmap_ptr = mmap(0, region->mmap_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, (file_offset & MASK_4K_ADDR));
+        if (wc_fd != -1)
+        {
+            close(wc_fd);       // the mapping keeps the resource
+        }
+        if (region->mmap_ptr == MAP_FAILED)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Failed to map the write-combined region 0x%lX:0x%lX.  (Error code %d)", region->offset, region->size, errno);
+            region->mmap_ptr = NULL;
+            ret = false;
+            break;
+        }
+        base = (char *)region->mmap_ptr + (file_offset & ~MASK_4K_ADDR);
+#else
+        // The software model has no device; the regions alias the model memory.
+        base = (char *)common_fpga_interface_info_vec_at(0)->base_address + region->offset;
+#endif
+
+        index = common_fpga_interface_info_vec_size();
+        common_fpga_interface_info_vec_resize(index + 1);
+        common_fpga_interface_info_vec_at(index)->base_address = base;
+        common_fpga_interface_info_vec_at(index)->dfh_parent = -1;
+        common_fpga_interface_info_vec_at(index)->write_combining = true;
+        common_fpga_interface_info_vec_at(index)->address_span = region->size;
+        common_fpga_interface_info_vec_at(index)->emulate_64bit = s_devmem_emulate_64bit != 0;
+        common_fpga_interface_hot_update(index);
+        region->index = index;
     }
 
     return ret;
 }
 
+#ifndef DEVMEM_UNIT_TEST_SW_MODEL_MODE
+/*
+the write-combined resource file of the PCI BAR holding the size bytes at the physical address addr, e.g.
+/sys/bus/pci/devices/0000:01:00.0/resource2_wc, and the offset of addr within the BAR; false if there is none
+*/
+bool devmem_get_sysfs_wc_resource_path(uint64_t addr, size_t size, char *path, int path_buf_size, size_t *bar_offset)
+{
+    enum
+    {
+        DEVMEM_SYSFS_PATH_SIZE = 1024
+    };
+    char resource_path[DEVMEM_SYSFS_PATH_SIZE + 1];
+    struct dirent *entry;
+    bool ret = false;
+    DIR *dir;
+
+    path[0] = '\0';
+    dir = opendir("/sys/bus/pci/devices");
+    if (dir == NULL)
+    {
+        return false;
+    }
+
+    while (!ret && (entry = readdir(dir)) != NULL)
+    {
+        uint64_t start;
+        uint64_t end;
+        uint64_t flags;
+        int bar = 0;
+        FILE *fp;
+
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+
+        // One line per resource, BARs first: <start> <end> <flags>
+        snprintf(resource_path, DEVMEM_SYSFS_PATH_SIZE, "/sys/bus/pci/devices/%s/resource", entry->d_name);
+        fp = fopen(resource_path, "r");
+        if (fp == NULL)
+        {
+            continue;
+        }
+        while (fscanf(fp, "%lx %lx %lx", &start, &end, &flags) == 3)
+        {
+            if (start != 0 && addr >= start && addr <= end && size <= end - addr + 1)
+            {
+                snprintf(path, path_buf_size, "/sys/bus/pci/devices/%s/resource%d_wc", entry->d_name, bar);
+                *bar_offset = (size_t)(addr - start);
+                ret = access(path, F_OK) == 0;      // only prefetchable BARs have one
+                break;
+            }
+            bar++;
+        }
+        fclose(fp);
+    }
+    closedir(dir);
+
+    if (!ret)
+    {
+        path[0] = '\0';
+    }
+    return ret;
+}
+#endif
+
+void devmem_unmap_wc_regions()
+{
+    unsigned int i;
+
+    for (i = 0; i < s_devmem_wc_region_count; ++i)
+    {
+        if (s_devmem_wc_regions[i].mmap_ptr != NULL)
+        {
+            munmap(s_devmem_wc_regions[i].mmap_ptr, s_devmem_wc_regions[i].mmap_size);
+            s_devmem_wc_regions[i].mmap_ptr = NULL;
+        }
+    }
+
+    if (s_devmem_wc_drv_handle >= 0)
+    {
+        close(s_devmem_wc_drv_handle);
+        s_devmem_wc_drv_handle = -1;
+    }
+}
+
+unsigned int fpga_get_num_of_wc_regions()
+{
+    return s_devmem_wc_region_count;
+}
+
+FPGA_MMIO_INTERFACE_HANDLE fpga_open_wc(unsigned int region)
+{
+    FPGA_MMIO_INTERFACE_HANDLE ret = FPGA_MMIO_INTERFACE_INVALID_HANDLE;
+
+    if (region < s_devmem_wc_region_count)
+    {
+        ret = fpga_open(s_devmem_wc_regions[region].index);
+    }
+
+    return ret;
+}
+
+void fpga_close_wc(unsigned int region)
+{
+    if (region < s_devmem_wc_region_count)
+    {
+        fpga_close(s_devmem_wc_regions[region].index);
+    }
+}
+
 bool devmem_create_unit_test_sw_model()
 {
     bool ret = true;
@@ -389,6 +829,9 @@ bool devmem_create_unit_test_sw_model()
     common_fpga_interface_info_vec_resize(1);
 
     common_fpga_interface_info_vec_at(0)->base_address = malloc(s_devmem_addr_span);
+    common_fpga_interface_info_vec_at(0)->address_span = s_devmem_addr_span;
+    common_fpga_interface_info_vec_at(0)->emulate_64bit = s_devmem_emulate_64bit != 0;
+    common_fpga_interface_hot_update(0);
     // Preset mem with all 1s
     memset(common_fpga_interface_info_vec_at(0)->base_address, 0xFF, s_devmem_addr_span);
 
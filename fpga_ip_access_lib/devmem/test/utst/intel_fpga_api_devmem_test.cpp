@@ -26,14 +26,19 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 #include <sstream>
 #include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
 using namespace std;
 
 #include "gtest/gtest.h"
 
 #include "intel_fpga_api_devmem.h"
 #include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_shadow.h"
 
 extern int optind;
 
@@ -372,6 +377,519 @@ TEST_F(MMIO, should_deal_with_mmio_512)
 }
 
 
+TEST_F(MMIO, should_deal_with_mmio_512_at_any_64bit_aligned_offset)
+{
+    int i;
+    int j;
+    uint8_t  wdata[512/8];
+    uint8_t  rdata[512/8];
+    const int  BYTES_PER_64_BIT = 64/8;
+    const int  BYTES_PER_UNIT = 512/8;
+    const int  START_OFFSET = 3072;
+
+    // Each 64-bit aligned offset within a 64-byte line selects a different vector path, depending on the alignment.
+    for(j = 0; j < BYTES_PER_UNIT/BYTES_PER_64_BIT; ++j)
+    {
+        uint32_t offset = START_OFFSET + j * (BYTES_PER_UNIT + BYTES_PER_64_BIT);
+        s_msg_buffer[0] = '\0';
+        ::snprintf( s_msg_buffer, MSG_BUFFER_SIZE, "Offset iteration (j): %d", j );
+        SCOPED_TRACE(s_msg_buffer);
+
+        for(i = 0; i < BYTES_PER_UNIT; ++i)
+        {
+            wdata[i] = (uint8_t)(i + j);
+        }
+        fpga_write_512(m_handle, offset, wdata);
+
+        for(i = 0; i < BYTES_PER_UNIT/BYTES_PER_64_BIT; ++i)
+        {
+            EXPECT_EQ(*((uint64_t *)wdata + i), fpga_read_64(m_handle, offset + i * BYTES_PER_64_BIT));
+        }
+        EXPECT_EQ(0xffffffffffffffff, fpga_read_64(m_handle, offset - BYTES_PER_64_BIT));
+        EXPECT_EQ(0xffffffffffffffff, fpga_read_64(m_handle, offset + BYTES_PER_UNIT));
+
+        fpga_read_512(m_handle, offset, rdata);
+        EXPECT_EQ(0, memcmp(wdata, rdata, BYTES_PER_UNIT));
+    }
+}
+
+
+TEST_F(MMIO, should_deal_with_mmio_batch)
+{
+    uint8_t   rdata_8 = 0;
+    uint16_t  rdata_16 = 0;
+    uint32_t  rdata_32 = 0;
+    uint64_t  rdata_64 = 0;
+    uint64_t  rdata_untouched = 0;
+    const uint32_t  START_OFFSET = 2048;
+
+    const FPGA_MMIO_BATCH_DESC wdesc[] =
+    {
+        { FPGA_MMIO_BATCH_WRITE, 8,  START_OFFSET + 1,  { .value = 0x5a } },
+        { FPGA_MMIO_BATCH_WRITE, 16, START_OFFSET + 2,  { .value = 0x1234 } },
+        { FPGA_MMIO_BATCH_WRITE, 32, START_OFFSET + 4,  { .value = 0xdeadbeef } },
+        { FPGA_MMIO_BATCH_WRITE, 64, START_OFFSET + 8,  { .value = 0x0123456789abcdefULL } }
+    };
+    EXPECT_EQ(0, fpga_mmio_batch(m_handle, wdesc, sizeof(wdesc)/sizeof(wdesc[0])));
+
+    EXPECT_EQ(0x5a, fpga_read_8(m_handle, START_OFFSET + 1));
+    EXPECT_EQ(0x1234, fpga_read_16(m_handle, START_OFFSET + 2));
+    EXPECT_EQ(0xdeadbeef, fpga_read_32(m_handle, START_OFFSET + 4));
+    EXPECT_EQ(0x0123456789abcdefULL, fpga_read_64(m_handle, START_OFFSET + 8));
+
+    FPGA_MMIO_BATCH_DESC rdesc[5];
+    rdesc[0] = { FPGA_MMIO_BATCH_READ, 8,  START_OFFSET + 1,  { .ptr = &rdata_8 } };
+    rdesc[1] = { FPGA_MMIO_BATCH_READ, 16, START_OFFSET + 2,  { .ptr = &rdata_16 } };
+    rdesc[2] = { FPGA_MMIO_BATCH_READ, 32, START_OFFSET + 4,  { .ptr = &rdata_32 } };
+    rdesc[3] = { FPGA_MMIO_BATCH_READ, 64, START_OFFSET + 8,  { .ptr = &rdata_64 } };
+    rdesc[4] = { FPGA_MMIO_BATCH_READ, 64, START_OFFSET + 16, { .ptr = &rdata_untouched } };
+    EXPECT_EQ(0, fpga_mmio_batch(m_handle, rdesc, 5));
+
+    EXPECT_EQ(0x5a, rdata_8);
+    EXPECT_EQ(0x1234, rdata_16);
+    EXPECT_EQ(0xdeadbeef, rdata_32);
+    EXPECT_EQ(0x0123456789abcdefULL, rdata_64);
+    EXPECT_EQ(0xffffffffffffffff, rdata_untouched);
+    EXPECT_EQ(0xff, fpga_read_8(m_handle, START_OFFSET));
+
+    EXPECT_EQ(-1, fpga_mmio_batch(m_handle + 1, rdesc, 5));
+    EXPECT_EQ(0, fpga_mmio_batch(m_handle, rdesc, 0));
+}
+
+
+TEST_F(MMIO, should_deal_with_mmio_block)
+{
+    unsigned int i;
+    unsigned int k;
+    uint8_t  wdata[300];
+    uint8_t  rdata[300 + 1];
+    const uint32_t  START_OFFSET = 2560;
+    const uint32_t  REGION_SIZE = 512;
+    // Cover unaligned heads and tails, tiny buffers and a middle long enough for every vector width.
+    const struct { uint32_t offset; size_t len; } cases[] =
+    {
+        { 0, 0 }, { 0, 1 }, { 1, 1 }, { 1, 2 }, { 2, 1 }, { 3, 3 }, { 6, 3 }, { 4, 2 },
+        { 0, 8 }, { 1, 8 }, { 5, 13 }, { 8, 64 }, { 0, 128 }, { 7, 200 }, { 64, 256 }, { 3, 300 }
+    };
+
+    for(i = 0; i < sizeof(wdata); ++i)
+    {
+        wdata[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    for(k = 0; k < sizeof(cases)/sizeof(cases[0]); ++k)
+    {
+        const uint32_t offset = START_OFFSET + cases[k].offset;
+        const size_t   len = cases[k].len;
+        s_msg_buffer[0] = '\0';
+        ::snprintf( s_msg_buffer, MSG_BUFFER_SIZE, "Case (offset, len): %u, %zu", cases[k].offset, len );
+        SCOPED_TRACE(s_msg_buffer);
+
+        for(i = 0; i < REGION_SIZE; ++i)
+        {
+            fpga_write_8(m_handle, START_OFFSET + i, 0xff);
+        }
+
+        EXPECT_EQ(0, fpga_write_block(m_handle, offset, wdata, len));
+        for(i = 0; i < REGION_SIZE; ++i)
+        {
+            if (START_OFFSET + i >= offset && START_OFFSET + i < offset + len)
+            {
+                EXPECT_EQ(wdata[START_OFFSET + i - offset], fpga_read_8(m_handle, START_OFFSET + i));
+            }
+            else
+            {
+                EXPECT_EQ(0xff, fpga_read_8(m_handle, START_OFFSET + i));
+            }
+        }
+
+        memset(rdata, 0, sizeof(rdata));
+        EXPECT_EQ(0, fpga_read_block(m_handle, offset, rdata, len));
+        EXPECT_EQ(0, memcmp(wdata, rdata, len));
+        EXPECT_EQ(0, rdata[len]);
+    }
+
+    EXPECT_EQ(-1, fpga_read_block(m_handle + 1, START_OFFSET, rdata, 8));
+    EXPECT_EQ(-1, fpga_write_block(m_handle + 1, START_OFFSET, wdata, 8));
+}
+
+TEST_F(MMIO, should_deal_with_fast_handle)
+{
+    unsigned int i;
+    uint8_t  wdata[512/8];
+    uint8_t  rdata[512/8];
+    const uint32_t  START_OFFSET = 1536;
+
+    FPGA_MMIO_FAST_HANDLE fast = fpga_open_fast(m_handle);
+    EXPECT_TRUE(fast.base != NULL);
+    EXPECT_EQ(4096u, fast.span);
+    EXPECT_EQ(0u, fast.flags & FPGA_MMIO_FAST_HANDLE_WRITE_COMBINING);
+
+    fpga_fast_write_8(fast, START_OFFSET, 0x5a);
+    fpga_fast_write_16(fast, START_OFFSET + 2, 0x1234);
+    fpga_fast_write_32(fast, START_OFFSET + 4, 0xdeadbeef);
+    fpga_fast_write_64(fast, START_OFFSET + 8, 0x0123456789abcdefULL);
+    EXPECT_EQ(0x5a, fpga_read_8(m_handle, START_OFFSET));
+    EXPECT_EQ(0x1234, fpga_read_16(m_handle, START_OFFSET + 2));
+    EXPECT_EQ(0xdeadbeef, fpga_read_32(m_handle, START_OFFSET + 4));
+    EXPECT_EQ(0x0123456789abcdefULL, fpga_read_64(m_handle, START_OFFSET + 8));
+
+    fpga_write_64(m_handle, START_OFFSET + 16, 0xfedcba9876543210ULL);
+    EXPECT_EQ(0x10, fpga_fast_read_8(fast, START_OFFSET + 16));
+    EXPECT_EQ(0x3210, fpga_fast_read_16(fast, START_OFFSET + 16));
+    EXPECT_EQ(0x76543210u, fpga_fast_read_32(fast, START_OFFSET + 16));
+    EXPECT_EQ(0xfedcba9876543210ULL, fpga_fast_read_64(fast, START_OFFSET + 16));
+
+    for(i = 0; i < sizeof(wdata); ++i)
+    {
+        wdata[i] = (uint8_t)(0x40 + i);
+    }
+    fpga_fast_write_512(fast, START_OFFSET + 64, wdata);
+    fpga_read_512(m_handle, START_OFFSET + 64, rdata);
+    EXPECT_EQ(0, memcmp(wdata, rdata, sizeof(wdata)));
+    memset(rdata, 0, sizeof(rdata));
+    fpga_fast_read_512(fast, START_OFFSET + 64, rdata);
+    EXPECT_EQ(0, memcmp(wdata, rdata, sizeof(wdata)));
+
+    fast = fpga_open_fast(m_handle + 1);
+    EXPECT_TRUE(fast.base == NULL);
+}
+
+TEST_F(MMIO, should_deal_with_poll_until)
+{
+    unsigned int k;
+    FPGA_POLL_RESULT result;
+    const uint32_t  START_OFFSET = 1792;
+    const uint64_t  TIMEOUT_NS = 200000;
+    const FPGA_POLL_POLICY policies[] = { FPGA_POLL_SPIN, FPGA_POLL_BACKOFF, FPGA_POLL_SLEEP };
+
+    fpga_write_64(m_handle, START_OFFSET, 0x00000000a5000001ULL);
+
+    for(k = 0; k < sizeof(policies)/sizeof(policies[0]); ++k)
+    {
+        s_msg_buffer[0] = '\0';
+        ::snprintf( s_msg_buffer, MSG_BUFFER_SIZE, "Policy: %d", policies[k] );
+        SCOPED_TRACE(s_msg_buffer);
+
+        memset(&result, 0, sizeof(result));
+        EXPECT_EQ(0, fpga_poll_until(m_handle, START_OFFSET, 32, 0xff000001, 0xa5000001, TIMEOUT_NS, policies[k], &result));
+        EXPECT_EQ(1u, result.read_count);
+        EXPECT_EQ(0xa5000001u, result.value);
+
+        memset(&result, 0, sizeof(result));
+        EXPECT_EQ(1, fpga_poll_until(m_handle, START_OFFSET, 8, 0x02, 0x02, TIMEOUT_NS, policies[k], &result));
+        EXPECT_GE(result.elapsed_ns, TIMEOUT_NS);
+        EXPECT_GE(result.read_count, 1u);
+        EXPECT_EQ(0x01u, result.value);
+    }
+
+    EXPECT_EQ(0, fpga_poll_until(m_handle, START_OFFSET, 64, ~0ULL, 0x00000000a5000001ULL, 0, FPGA_POLL_SPIN, NULL));
+    EXPECT_EQ(1, fpga_poll_until(m_handle, START_OFFSET + 2, 16, 0xffff, 0, 0, FPGA_POLL_SPIN, &result));
+    EXPECT_EQ(1u, result.read_count);
+    EXPECT_EQ(-1, fpga_poll_until(m_handle + 1, START_OFFSET, 32, 0, 0, 0, FPGA_POLL_SPIN, NULL));
+}
+
+TEST_F(MMIO, should_deal_with_shadow_registers)
+{
+    FPGA_SHADOW_STATS stats;
+    const uint32_t  START_OFFSET = 1920;
+
+    EXPECT_EQ(0, fpga_shadow_get_stats(m_handle, &stats));
+    EXPECT_EQ(0u, stats.avoided_reads);
+
+    fpga_write_32(m_handle, START_OFFSET, 0x000000f0);
+    fpga_write_64(m_handle, START_OFFSET + 8, 0x1111111100000000ULL);
+    EXPECT_EQ(0, fpga_shadow_add_range(m_handle, START_OFFSET, 16));
+
+    // The first access of a shadowed register reads the device; the following ones are served from the shadow.
+    EXPECT_EQ(0x000000f3u, fpga_rmw_32(m_handle, START_OFFSET, 0x00000000, 0x00000003));
+    EXPECT_EQ(0x000000e3u, fpga_rmw_32(m_handle, START_OFFSET, 0x00000010, 0x00000000));
+    EXPECT_EQ(0x000000e3u, fpga_read_32(m_handle, START_OFFSET));
+    EXPECT_EQ(0x000000e3u, fpga_shadow_read_32(m_handle, START_OFFSET));
+
+    fpga_shadow_write_64(m_handle, START_OFFSET + 8, 0x2222222200000001ULL);
+    EXPECT_EQ(0x2222222200000003ULL, fpga_rmw_64(m_handle, START_OFFSET + 8, 0, 0x2));
+    EXPECT_EQ(0x2222222200000003ULL, fpga_read_64(m_handle, START_OFFSET + 8));
+
+    EXPECT_EQ(0, fpga_shadow_get_stats(m_handle, &stats));
+    EXPECT_EQ(1u, stats.reads);
+    EXPECT_EQ(3u, stats.avoided_reads);
+    EXPECT_EQ(4u, stats.writes);
+
+    // Changes behind the shadow are only seen after an invalidate or a refresh.
+    fpga_write_32(m_handle, START_OFFSET, 0x0000abcd);
+    EXPECT_EQ(0x000000e3u, fpga_shadow_read_32(m_handle, START_OFFSET));
+    EXPECT_EQ(0, fpga_shadow_invalidate(m_handle));
+    EXPECT_EQ(0x0000abcdu, fpga_shadow_read_32(m_handle, START_OFFSET));
+    fpga_write_32(m_handle, START_OFFSET + 4, 0x12345678);
+    EXPECT_EQ(0, fpga_shadow_refresh(m_handle));
+    EXPECT_EQ(0x12345678u, fpga_shadow_read_32(m_handle, START_OFFSET + 4));
+
+    // Offsets out of the declared ranges are always read from the device.
+    FPGA_SHADOW_STATS before;
+    EXPECT_EQ(0, fpga_shadow_get_stats(m_handle, &before));
+    EXPECT_EQ(0xffu, fpga_rmw_32(m_handle, START_OFFSET + 16, 0xffffff00, 0));
+    EXPECT_EQ(0xffu, fpga_rmw_32(m_handle, START_OFFSET + 16, 0xffffff00, 0));
+    EXPECT_EQ(0, fpga_shadow_get_stats(m_handle, &stats));
+    EXPECT_EQ(before.reads + 2, stats.reads);
+    EXPECT_EQ(before.avoided_reads, stats.avoided_reads);
+
+    EXPECT_EQ(-1, fpga_shadow_add_range(m_handle + 1, START_OFFSET, 16));
+    EXPECT_EQ(-1, fpga_shadow_invalidate(m_handle + 1));
+    EXPECT_EQ(-1, fpga_shadow_get_stats(m_handle + 1, &stats));
+    EXPECT_EQ(0u, fpga_shadow_read_32(m_handle + 1, START_OFFSET));
+    fpga_shadow_write_64(m_handle + 1, START_OFFSET, 0);
+    EXPECT_EQ(0u, fpga_rmw_32(m_handle + 1, START_OFFSET, 0, 1));
+    EXPECT_NE(std::string::npos, m_devmem_msg_oss.str().find("invalid interface handle"));
+
+    // Unaligned offsets would alias a shadow slot, so they are rejected without touching the device or the shadow.
+    fpga_shadow_write_32(m_handle, START_OFFSET + 2, 0xffffffff);
+    fpga_shadow_write_64(m_handle, START_OFFSET + 6, ~0ULL);
+    EXPECT_EQ(0u, fpga_shadow_read_32(m_handle, START_OFFSET + 1));
+    EXPECT_EQ(0u, fpga_shadow_read_64(m_handle, START_OFFSET + 6));
+    EXPECT_EQ(0x0000abcdu, fpga_shadow_read_32(m_handle, START_OFFSET));
+    EXPECT_EQ(0x0000abcdu, fpga_read_32(m_handle, START_OFFSET));
+    EXPECT_EQ(0x12345678u, fpga_shadow_read_32(m_handle, START_OFFSET + 4));
+    EXPECT_NE(std::string::npos, m_devmem_msg_oss.str().find("is not 32-bit aligned"));
+}
+
+TEST_F(MMIO, should_deal_with_relaxed_mmio_and_barriers)
+{
+    const uint32_t  START_OFFSET = 1984;
+
+    fpga_write_8_relaxed(m_handle, START_OFFSET, 0x5a);
+    fpga_write_16_relaxed(m_handle, START_OFFSET + 2, 0x1234);
+    fpga_write_32_relaxed(m_handle, START_OFFSET + 4, 0xdeadbeef);
+    fpga_write_64_relaxed(m_handle, START_OFFSET + 8, 0x0123456789abcdefULL);
+    fpga_mmio_wmb();
+    fpga_mmio_flush(m_handle);
+
+    EXPECT_EQ(0x5a, fpga_read_8_relaxed(m_handle, START_OFFSET));
+    EXPECT_EQ(0x1234, fpga_read_16_relaxed(m_handle, START_OFFSET + 2));
+    EXPECT_EQ(0xdeadbeef, fpga_read_32_relaxed(m_handle, START_OFFSET + 4));
+    EXPECT_EQ(0x0123456789abcdefULL, fpga_read_64_relaxed(m_handle, START_OFFSET + 8));
+    fpga_mmio_rmb();
+    fpga_mmio_mb();
+
+    EXPECT_EQ(0x5a, fpga_read_8(m_handle, START_OFFSET));
+    EXPECT_EQ(0x0123456789abcdefULL, fpga_read_64(m_handle, START_OFFSET + 8));
+}
+
+TEST_F(MMIO, should_deal_with_64bit_emulation_per_interface)
+{
+    const uint32_t  START_OFFSET = 2016;
+    bool native = !fpga_devmem_is_64bit_emulated(m_handle);
+
+    EXPECT_EQ(-1, fpga_set_64bit_emulation(m_handle + 1, true));
+
+    EXPECT_EQ(0, fpga_set_64bit_emulation(m_handle, true));
+    EXPECT_TRUE(fpga_devmem_is_64bit_emulated(m_handle));
+    fpga_write_64(m_handle, START_OFFSET, 0x0123456789abcdefULL);
+    EXPECT_EQ(0x0123456789abcdefULL, fpga_read_64(m_handle, START_OFFSET));
+    EXPECT_EQ(0x89abcdef, fpga_read_32(m_handle, START_OFFSET));
+    EXPECT_EQ(0x01234567, fpga_read_32(m_handle, START_OFFSET + 4));
+
+    FPGA_MMIO_FAST_HANDLE fast = fpga_open_fast(m_handle);
+    EXPECT_TRUE(fast.flags & FPGA_MMIO_FAST_HANDLE_EMULATE_64BIT);
+    fpga_fast_write_64(fast, START_OFFSET + 8, 0xfedcba9876543210ULL);
+    EXPECT_EQ(0xfedcba9876543210ULL, fpga_fast_read_64(fast, START_OFFSET + 8));
+
+    EXPECT_EQ(0, fpga_set_64bit_emulation(m_handle, !native));
+    fast = fpga_open_fast(m_handle);
+    EXPECT_EQ(0x0123456789abcdefULL, fpga_read_64(m_handle, START_OFFSET));
+    EXPECT_EQ(0xfedcba9876543210ULL, fpga_fast_read_64(fast, START_OFFSET + 8));
+}
+
+// the accessors use the state copied at fpga_open(), which follows the interface information
+TEST_F(MMIO, should_deal_with_base_address_moved_before_open)
+{
+    const uint32_t  START_OFFSET = 64;
+    FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(m_handle);
+    void *base_address = info->base_address;
+
+    fpga_write_32(m_handle, START_OFFSET, 0x12345678);
+    EXPECT_EQ((volatile uint8_t *)base_address, common_fpga_interface_hot_at(m_handle)->base);
+
+    fpga_close(m_handle);
+    info->base_address = (uint8_t *)base_address + START_OFFSET;
+    m_handle = fpga_open(0);
+    ASSERT_NE(FPGA_MMIO_INTERFACE_INVALID_HANDLE, m_handle);
+    EXPECT_EQ(0x12345678u, fpga_read_32(m_handle, 0));
+
+    fpga_close(m_handle);
+    info->base_address = base_address;
+    m_handle = fpga_open(0);
+    EXPECT_EQ(0x12345678u, fpga_read_32(m_handle, START_OFFSET));
+}
+
+TEST_F(MMIO, should_deal_with_concurrent_open_and_lock)
+{
+    const uint32_t  COUNTER_OFFSET = 2040;
+    const int       NUM_THREADS = 4;
+    const int       NUM_INCREMENTS = 1000;
+    vector<thread>  threads;
+    atomic<int>     num_opened(0);
+
+    fpga_close(0);
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        threads.emplace_back([&num_opened]() {
+            if (fpga_open(0) != FPGA_MMIO_INTERFACE_INVALID_HANDLE)
+            {
+                num_opened++;
+            }
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    threads.clear();
+    EXPECT_EQ(1, num_opened.load());
+    EXPECT_EQ(FPGA_MMIO_INTERFACE_INVALID_HANDLE, fpga_open(0));
+
+    EXPECT_EQ(-1, fpga_lock(m_handle + 1));
+    EXPECT_EQ(-1, fpga_trylock(m_handle + 1));
+    EXPECT_EQ(-1, fpga_unlock(m_handle + 1));
+    EXPECT_EQ(0, fpga_trylock(m_handle));
+    EXPECT_EQ(1, fpga_trylock(m_handle));
+    EXPECT_EQ(0, fpga_unlock(m_handle));
+
+    fpga_write_32(m_handle, COUNTER_OFFSET, 0);
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        threads.emplace_back([this, COUNTER_OFFSET, NUM_INCREMENTS]() {
+            for (int j = 0; j < NUM_INCREMENTS; j++)
+            {
+                fpga_lock(m_handle);
+                fpga_write_32(m_handle, COUNTER_OFFSET, fpga_read_32(m_handle, COUNTER_OFFSET) + 1);
+                fpga_unlock(m_handle);
+            }
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ((uint32_t)(NUM_THREADS * NUM_INCREMENTS), fpga_read_32(m_handle, COUNTER_OFFSET));
+}
+
+
+class MMIO_WC : public ::testing::Test  
+{
+public:
+    void SetUp()
+    {
+        optind = 0;     // Reset getopt_long position.
+        s_devmem_msg_oss = &m_devmem_msg_oss;
+        fpga_platform_register_printf(s_devmem_utst_printf);
+        fpga_platform_register_runtime_exception_handler(s_devmem_utst_exception_handler); 
+        const char *argv_valid[] =
+        {
+            "program",
+            "--single-component-mode",
+            "--start-address=0x80000000",
+            "--address-span=4096",
+            "--wc-region=0x800:0x100",
+            "--wc-region=3072:64"
+        };
+        
+        bool rc = fpga_platform_init(sizeof(argv_valid)/sizeof(argv_valid[0]), argv_valid);
+        EXPECT_TRUE(rc);
+
+        EXPECT_STREQ(
+            "INFO: Devmem Platform Configuration:"
+            "INFO:    Driver Path: /dev/mem"
+            "INFO:    Address Span: 4096"
+            "INFO:    Start Address: 0x80000000"
+            "INFO:    Single Component Operation Model: Yes"
+            "INFO:    Write-Combined Region: 0x800:0x100"
+            "INFO:    Write-Combined Region: 0xC00:0x40",
+            m_devmem_msg_oss.str().c_str());
+
+        m_handle = fpga_open(0);
+        EXPECT_TRUE(m_handle != FPGA_MMIO_INTERFACE_INVALID_HANDLE);
+    }
+
+    void TearDown()
+    {
+        fpga_close(0);
+        
+        fpga_platform_cleanup();
+    }
+   
+
+protected:
+
+    FPGA_MMIO_INTERFACE_HANDLE  m_handle;
+    ostringstream               m_devmem_msg_oss;
+};
+
+TEST_F(MMIO_WC, should_expose_wc_regions_as_interfaces)
+{
+    FPGA_INTERFACE_INFO info;
+
+    EXPECT_EQ(3, (int)fpga_get_num_of_interfaces());
+    EXPECT_EQ(2, (int)fpga_get_num_of_wc_regions());
+
+    EXPECT_TRUE(fpga_get_interface_at(0, &info));
+    EXPECT_FALSE(info.write_combining);
+    EXPECT_TRUE(fpga_get_interface_at(1, &info));
+    EXPECT_TRUE(info.write_combining);
+    EXPECT_EQ(-1, info.dfh_parent);
+    EXPECT_TRUE(fpga_get_interface_at(2, &info));
+    EXPECT_TRUE(info.write_combining);
+
+    EXPECT_EQ(FPGA_MMIO_INTERFACE_INVALID_HANDLE, fpga_open_wc(2));
+}
+
+TEST_F(MMIO_WC, should_fill_the_accessor_state_before_open)
+{
+    for (unsigned int i = 0; i < fpga_get_num_of_interfaces(); i++)
+    {
+        EXPECT_EQ((volatile uint8_t *)common_fpga_interface_info_vec_at(i)->base_address, common_fpga_interface_hot_at(i)->base) << "differ at index " << i;
+        EXPECT_EQ(common_fpga_interface_info_vec_at(i)->emulate_64bit, common_fpga_interface_hot_at(i)->emulate_64bit) << "differ at index " << i;
+    }
+
+    // the WC regions alias the interface memory in the software model; region 1 has not been opened
+    fpga_write_32(m_handle, 0x800, 0x5a5aa5a5);
+    EXPECT_EQ(0x5a5aa5a5u, fpga_read_32(1, 0));
+}
+
+TEST_F(MMIO_WC, should_deal_with_wc_region_access)
+{
+    uint8_t  wdata[512/8];
+    uint8_t  rdata[512/8];
+    unsigned int i;
+
+    FPGA_MMIO_INTERFACE_HANDLE wc_handle = fpga_open_wc(0);
+    EXPECT_TRUE(wc_handle != FPGA_MMIO_INTERFACE_INVALID_HANDLE);
+    EXPECT_EQ(FPGA_MMIO_INTERFACE_INVALID_HANDLE, fpga_open_wc(0));
+
+    FPGA_MMIO_FAST_HANDLE fast = fpga_open_fast(wc_handle);
+    EXPECT_EQ(0x100u, fast.span);
+    EXPECT_EQ((uint32_t)FPGA_MMIO_FAST_HANDLE_WRITE_COMBINING, fast.flags & FPGA_MMIO_FAST_HANDLE_WRITE_COMBINING);
+
+    for(i = 0; i < sizeof(wdata); ++i)
+    {
+        wdata[i] = (uint8_t)(0x80 + i);
+    }
+    fpga_write_32(wc_handle, 0x10, 0x12345678);
+    fpga_write_512(wc_handle, 0x40, wdata);
+    fpga_wc_flush(wc_handle);
+
+    EXPECT_EQ(0x12345678, fpga_read_32(m_handle, 0x800 + 0x10));
+    fpga_read_512(m_handle, 0x800 + 0x40, rdata);
+    EXPECT_EQ(0, memcmp(wdata, rdata, sizeof(wdata)));
+    EXPECT_EQ(0xffffffff, fpga_read_32(m_handle, 0x800 + 0x14));
+
+    fpga_close_wc(0);
+    wc_handle = fpga_open_wc(0);
+    EXPECT_TRUE(wc_handle != FPGA_MMIO_INTERFACE_INVALID_HANDLE);
+    fpga_close_wc(0);
+}
+
+
 class MMIO_NON_4K_ALIGNED : public ::testing::Test  
 {
 public:
@@ -32,6 +32,7 @@ using namespace std;
 
 #include "gtest/gtest.h"
 
+#include "intel_fpga_api_devmem.h"
 #include "intel_fpga_platform_api_devmem.h"
 #include "intel_fpga_api_cmn_msg.h"
 
@@ -343,6 +344,37 @@ TEST_F(Argument, should_deal_with_valid_argument_with_optional_single_mode)
     fpga_platform_cleanup();
 }
 
+TEST_F(Argument, should_deal_with_valid_argument_with_short_emulate_64bit)
+{
+    const char *argv_valid[] =
+    {
+        "program",
+        "--single-component-mode",
+        "--start-address=0x80000000",
+        "--address-span=4096",
+        "-e"
+    };
+
+    bool rc = fpga_platform_init(5, argv_valid);
+    EXPECT_TRUE(rc);
+
+    EXPECT_STREQ(
+        "INFO: Devmem Platform Configuration:"
+        "INFO:    Driver Path: /dev/mem"
+        "INFO:    Address Span: 4096"
+        "INFO:    Start Address: 0x80000000"
+        "INFO:    Single Component Operation Model: Yes"
+        "INFO:    64-bit Access Emulation: Yes",
+        m_devmem_msg_oss.str().c_str());
+
+    FPGA_MMIO_INTERFACE_HANDLE handle = fpga_open(0);
+    EXPECT_TRUE(handle != FPGA_MMIO_INTERFACE_INVALID_HANDLE);
+    EXPECT_TRUE(fpga_devmem_is_64bit_emulated(handle));
+    fpga_close(0);
+
+    fpga_platform_cleanup();
+}
+
 TEST_F(Argument, should_deal_with_valid_argument_with_DFL)
 {
     const char *argv_valid[] =
@@ -367,6 +399,113 @@ TEST_F(Argument, should_deal_with_valid_argument_with_DFL)
     fpga_platform_cleanup();
 }
 
+TEST_F(Argument, should_deal_with_valid_argument_with_DFL_rom_snapshot)
+{
+    const char *argv_valid[] =
+        {
+            "program",
+            "--dfl-entry-address=0x10000",
+            "--start-address=0x10000",
+            "--address-span=0x12345678",
+            "--dfl-rom-snapshot=0x1000"};
+
+    bool rc = fpga_platform_init(5, argv_valid);
+    EXPECT_TRUE(rc);
+
+    EXPECT_STREQ(
+        "INFO: Devmem Platform Configuration:"
+        "INFO:    Driver Path: /dev/mem"
+        "INFO:    Address Span: 305419896"
+        "INFO:    Start Address: 0x10000"
+        "INFO:    DFL Operation Model: Yes"
+        "INFO:    DFL Entry Address: 0x10000"
+        "INFO:    DFL ROM Snapshot: Yes"
+        "INFO:    DFL ROM Snapshot Size: 4096",
+        m_devmem_msg_oss.str().c_str());
+
+    fpga_platform_cleanup();
+}
+
+TEST_F(Argument, should_deal_with_valid_argument_with_DFL_scan_limits)
+{
+    const char *argv_valid[] =
+        {
+            "program",
+            "--dfl-entry-address=0x10000",
+            "--start-address=0x10000",
+            "--address-span=0x12345678",
+            "--dfl-max-depth=4",
+            "--dfl-max-interfaces=64"};
+
+    bool rc = fpga_platform_init(6, argv_valid);
+    EXPECT_TRUE(rc);
+
+    EXPECT_STREQ(
+        "INFO: Devmem Platform Configuration:"
+        "INFO:    Driver Path: /dev/mem"
+        "INFO:    Address Span: 305419896"
+        "INFO:    Start Address: 0x10000"
+        "INFO:    DFL Operation Model: Yes"
+        "INFO:    DFL Entry Address: 0x10000"
+        "INFO:    DFL Max Depth: 4"
+        "INFO:    DFL Max Interfaces: 64",
+        m_devmem_msg_oss.str().c_str());
+
+    fpga_platform_cleanup();
+}
+
+TEST_F(Argument, should_deal_with_valid_argument_with_DFL_scan_workers)
+{
+    const char *argv_valid[] =
+        {
+            "program",
+            "--dfl-entry-address=0x10000",
+            "--start-address=0x10000",
+            "--address-span=0x12345678",
+            "--dfl-scan-workers=4"};
+
+    bool rc = fpga_platform_init(5, argv_valid);
+    EXPECT_TRUE(rc);
+
+    EXPECT_STREQ(
+        "INFO: Devmem Platform Configuration:"
+        "INFO:    Driver Path: /dev/mem"
+        "INFO:    Address Span: 305419896"
+        "INFO:    Start Address: 0x10000"
+        "INFO:    DFL Operation Model: Yes"
+        "INFO:    DFL Entry Address: 0x10000"
+        "INFO:    DFL Scan Workers: 4",
+        m_devmem_msg_oss.str().c_str());
+
+    fpga_platform_cleanup();
+}
+
+TEST_F(Argument, should_deal_with_valid_argument_with_DFL_param_views)
+{
+    const char *argv_valid[] =
+        {
+            "program",
+            "--dfl-entry-address=0x10000",
+            "--start-address=0x10000",
+            "--address-span=0x12345678",
+            "--dfl-param-views"};
+
+    bool rc = fpga_platform_init(5, argv_valid);
+    EXPECT_TRUE(rc);
+
+    EXPECT_STREQ(
+        "INFO: Devmem Platform Configuration:"
+        "INFO:    Driver Path: /dev/mem"
+        "INFO:    Address Span: 305419896"
+        "INFO:    Start Address: 0x10000"
+        "INFO:    DFL Operation Model: Yes"
+        "INFO:    DFL Entry Address: 0x10000"
+        "INFO:    DFL Parameter Views: Yes",
+        m_devmem_msg_oss.str().c_str());
+
+    fpga_platform_cleanup();
+}
+
 TEST_F(Argument, should_deal_with_invalid_argument_with_DFL_lower)
 {
     const char *argv_valid[] =
@@ -404,3 +543,41 @@ TEST_F(Argument, should_deal_with_invalid_argument_with_DFL_higher)
 
     fpga_platform_cleanup();
 }
+
+TEST_F(Argument, should_deal_with_invalid_wc_region_format)
+{
+    const char *argv_invalid[] =
+        {
+            "program",
+            "--start-address=0x10000",
+            "--address-span=0x1000",
+            "--wc-region=0x800"};
+
+    bool rc = fpga_platform_init(4, argv_invalid);
+    EXPECT_FALSE(rc);
+
+    EXPECT_STREQ(
+        "ERROR: Invalid write-combined region. <offset>:<size> is expected. 0x800 is provided.",
+        m_devmem_msg_oss.str().c_str());
+
+    fpga_platform_cleanup();
+}
+
+TEST_F(Argument, should_deal_with_invalid_wc_region_range)
+{
+    const char *argv_invalid[] =
+        {
+            "program",
+            "--start-address=0x10000",
+            "--address-span=0x1000",
+            "--wc-region=0x800:0x801"};
+
+    bool rc = fpga_platform_init(4, argv_invalid);
+    EXPECT_FALSE(rc);
+
+    EXPECT_STREQ(
+        "ERROR: Write-combined region 0x800:0x801 is not within the range based on the argument --address-span.",
+        m_devmem_msg_oss.str().c_str());
+
+    fpga_platform_cleanup();
+}
@@ -60,6 +60,12 @@
 *
 * @endcode
 *
+* @note MMIO ordering.  fpga_read_N() and fpga_write_N() are ordered with the memory accesses of the CPU: a write is
+* not issued before the prior stores to memory, e.g. to a DMA buffer, are visible, and a read completes before the
+* following loads from memory.  The fpga_read_N_relaxed() and fpga_write_N_relaxed() variants only keep the program order
+* of the accesses to the same interface.  Use them for a burst of register accesses and order the burst explicitly with
+* fpga_mmio_wmb(), fpga_mmio_rmb(), fpga_mmio_mb() or fpga_mmio_flush().
+*
 *
 * @{
 */
@@ -177,12 +183,62 @@ uint64_t fpga_read_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset);
 */
 void fpga_write_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint64_t value);
 
+/**
+* @brief The function provides the 32-bit MMIO read access without ordering against memory accesses.
+*
+* fpga_read_8_relaxed(), fpga_read_16_relaxed() and fpga_read_64_relaxed() are provided in the same way.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
+* @param[in] offset The address offset from the base address of the MMIO interface.
+*
+* @return The value read from the specified address.
+*/
+uint32_t fpga_read_32_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset);
+
+/**
+* @brief The function provides the 32-bit MMIO write access without ordering against memory accesses.
+*
+* fpga_write_8_relaxed(), fpga_write_16_relaxed() and fpga_write_64_relaxed() are provided in the same way.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
+* @param[in] offset The address offset from the base address of the MMIO interface.
+* @param[in] value The value to write to the specified address.
+*/
+void fpga_write_32_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t value);
+
+/**
+* @brief The function makes all prior stores, to memory or MMIO, complete before any later store.
+*/
+void fpga_mmio_wmb();
+
+/**
+* @brief The function makes all prior loads, from memory or MMIO, complete before any later load.
+*/
+void fpga_mmio_rmb();
+
+/**
+* @brief The function makes all prior loads and stores complete before any later load or store.
+*/
+void fpga_mmio_mb();
+
+/**
+* @brief The function pushes the posted writes to the MMIO interface out to the device.
+*
+* The writes are pushed by reading back the register at offset 0 of the interface, which must be readable without
+* side-effect.  When the function returns, the prior writes have reached the device.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
+*/
+void fpga_mmio_flush(FPGA_MMIO_INTERFACE_HANDLE handle);
+
 /**
 * @brief The function provides the 512-bit MMIO read access.
 * 
 * Read one 512-bit integer at the offset address relative to the MMIO interface.
 *
 * @note Use FPGA_PLATFORM_HAS_NATIVE_MMIO_READ_512 to determine whether this is natively supported.
+* On x86 platforms, the access uses the widest vector load available at run-time that the address alignment allows
+* (AVX-512, AVX2 or SSE2) and falls back to 64-bit reads otherwise.
 *
 * @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
 * @param[in] offset The address offset from the base address of the MMIO interface. The address offset specifies the byte address always, independent from the targeted hardware interface property.
@@ -197,6 +253,9 @@ void fpga_read_512(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint8_t *
 * Write one 512-bit integer at the offset address relative to the MMIO interface.
 *
 * @note Use FPGA_PLATFORM_HAS_NATIVE_MMIO_WRITE_512 to determine whether this is natively supported.
+* On x86 platforms, the access uses the widest non-temporal vector store available at run-time that the address alignment
+* allows (AVX-512, AVX2 or SSE2), followed by a store fence, and falls back to 64-bit writes otherwise.  On a write-combined
+* mapping, a 64-byte aligned write is issued as a single transaction.
 *
 * @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
 * @param[in] offset The address offset from the base address of the MMIO interface. The address offset specifies the byte address always, independent from the targeted hardware interface property.
@@ -205,6 +264,300 @@ void fpga_read_512(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint8_t *
 */
 void fpga_write_512(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint8_t *value);
 
+/**
+* @brief The function reports whether 512-bit MMIO access is a single transaction on the running CPU.
+*
+* FPGA_PLATFORM_HAS_NATIVE_MMIO_READ_512 and FPGA_PLATFORM_HAS_NATIVE_MMIO_WRITE_512 are only defined when the
+* library is built for such CPU.  This function reports the same capability detected at run-time.
+*
+* @return true if fpga_read_512() and fpga_write_512() at a 64-byte aligned address are single transactions; otherwise, false.
+*/
+bool fpga_has_native_mmio_512();
+
+/**
+* @brief The function executes a list of MMIO read and write accesses against one interface.
+* 
+* The handle is resolved once for the whole list and the accesses are issued in the array order.
+* A single memory barrier is issued after the last access, so the list costs one barrier instead of one per access.
+* Each entry follows the same alignment and emulation rules as the single access function of the same width.
+*
+* @code
+* uint64_t status;
+* const FPGA_MMIO_BATCH_DESC desc[] =
+* {
+*     { FPGA_MMIO_BATCH_WRITE, 32, 0x10, { .value = 0x1 } },
+*     { FPGA_MMIO_BATCH_WRITE, 64, 0x18, { .value = buffer_address } },
+*     { FPGA_MMIO_BATCH_READ,  64, 0x20, { .ptr = &status } }
+* };
+* fpga_mmio_batch(handle, desc, sizeof(desc)/sizeof(desc[0]));
+* @endcode
+*
+* @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
+* @param[in] desc The array of access descriptors.  The width is 8, 16, 32 or 64; a read stores the value into the width-sized buffer at ptr.
+* @param[in] count The number of entries in desc.
+* 
+* @return 0 if the list is executed; -1 if the handle is invalid.  An entry with an invalid operation or width generates a run-time exception.
+*/
+int fpga_mmio_batch(FPGA_MMIO_INTERFACE_HANDLE handle, const FPGA_MMIO_BATCH_DESC *desc, size_t count);
+
+/**
+* @brief The function selects whether 64-bit accesses on the MMIO interface are split into two 32-bit accesses.
+*
+* Some bridges, e.g. the Intel FPGA PCIe Memory Mapped Bridge IP, do not forward 64-bit accesses.  The default of each interface
+* comes from the platform argument that enables the emulation, e.g. --emulate-64bit.  A design can also describe it in a DFL
+* parameter of its own choosing, read only when its ID is given, e.g. with --dfl-mmio-access-param; no parameter ID is
+* allocated for this by the DFH specification.  fpga_read_64(), fpga_write_64(), the 512-bit accessors, fpga_mmio_batch() and the block
+* copies follow the setting; the low 32 bits are accessed first.  A fast handle captures the setting when fpga_open_fast() is called.
+* Defining FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT at compile time emulates on every interface regardless of the setting.
+*
+* @param[in] handle The handle to the targeted MMIO interface.
+* @param[in] enable true to split 64-bit accesses; false to issue native 64-bit accesses.
+*
+* @return 0 on success; -1 if the handle is invalid.
+*/
+int fpga_set_64bit_emulation(FPGA_MMIO_INTERFACE_HANDLE handle, bool enable);
+
+/**
+* @brief The function copies a buffer from the MMIO interface.
+*
+* Any offset and length are allowed.  The unaligned head and tail are read with 8-bit, 16-bit and 32-bit accesses, and the
+* aligned middle with the widest access available, e.g. vector loads on x86 platforms.  The middle is read with 32-bit accesses when
+* 64-bit accesses are emulated on the interface, see fpga_set_64bit_emulation().
+*
+* @warning The transaction sizes depend on the offset, the length and the platform.  Use this function only on memory-like regions,
+* e.g. on-chip RAM, that have no read side-effect.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
+* @param[in] offset The address offset from the base address of the MMIO interface where the copy starts.
+* @param[out] dst The buffer receiving len bytes.
+* @param[in] len The number of bytes to copy.
+*
+* @return 0 if the buffer is copied; -1 if the handle is invalid.
+*/
+int fpga_read_block(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, void *dst, size_t len);
+
+/**
+* @brief The function copies a buffer to the MMIO interface.
+*
+* Any offset and length are allowed.  The unaligned head and tail are written with 8-bit, 16-bit and 32-bit accesses, and the
+* aligned middle with the widest access available, e.g. non-temporal vector stores on x86 platforms.  The middle is written with 32-bit
+* accesses when 64-bit accesses are emulated on the interface, see fpga_set_64bit_emulation().
+*
+* @warning The transaction sizes depend on the offset, the length and the platform.  Use this function only on memory-like regions,
+* e.g. on-chip RAM.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
+* @param[in] offset The address offset from the base address of the MMIO interface where the copy starts.
+* @param[in] src The buffer holding len bytes.
+* @param[in] len The number of bytes to copy.
+*
+* @return 0 if the buffer is copied; -1 if the handle is invalid.
+*/
+int fpga_write_block(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, const void *src, size_t len);
+
+/**
+* @brief The function polls a register until the masked value matches or the timeout expires.
+*
+* The register is read until (read value & mask) == value.  The policy sets what happens between two reads:
+* FPGA_POLL_SPIN keeps the CPU busy with a relax hint; FPGA_POLL_BACKOFF and FPGA_POLL_SLEEP spin for a short window
+* first, then wait exponentially longer between reads, by busy-waiting and yielding or by sleeping respectively.
+* Backing off reduces the load on the CPU and on the link to the FPGA at the cost of a later detection.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  The type is specific to the platform.  Obtained with fpga_open().
+* @param[in] offset The address offset of the register from the base address of the MMIO interface.
+* @param[in] width The access width in bits: 8, 16, 32 or 64.
+* @param[in] mask The bits of the register to compare.
+* @param[in] value The expected value of the masked bits.
+* @param[in] timeout_ns The timeout in nanoseconds.  The register is read at least once.
+* @param[in] policy The polling policy.
+* @param[out] result The elapsed time, the number of reads and the last value read.  It may be NULL.
+*
+* @return 0 if the value matches; 1 on timeout; -1 if the handle is invalid.
+*/
+int fpga_poll_until(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t width, uint64_t mask, uint64_t value,
+                    uint64_t timeout_ns, FPGA_POLL_POLICY policy, FPGA_POLL_RESULT *result);
+
+/**
+* @brief Register shadow statistics returned by fpga_shadow_get_stats()
+*/
+typedef struct
+{
+    uint64_t                     reads;             //!< Register reads issued to the device
+    uint64_t                     avoided_reads;     //!< Register reads served from the shadow instead
+    uint64_t                     writes;            //!< Register writes issued to the device
+} FPGA_SHADOW_STATS;
+
+/**
+* @brief The function declares a range of registers of the MMIO interface as cacheable in the register shadow.
+*
+* The register shadow is opt-in and meant for write-mostly control registers.  The registers within a declared range keep
+* the last value written or read in host memory, so that fpga_shadow_read_32(), fpga_shadow_read_64(), fpga_rmw_32()
+* and fpga_rmw_64() issue no MMIO read once the value is known.  Offsets out of the declared ranges are always accessed
+* on the device.
+*
+* @warning The shadow is only coherent when every write to a shadowed register goes through fpga_shadow_write_32(),
+* fpga_shadow_write_64(), fpga_rmw_32() or fpga_rmw_64().  Call fpga_shadow_invalidate() or fpga_shadow_refresh() when
+* the registers may have changed otherwise, e.g. after a reset of the IP.  Do not shadow registers with read side-effects
+* or hardware-updated fields.
+*
+* @note The shadow functions are not serialized.  Hold fpga_lock() around them when several threads share the interface.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open().
+* @param[in] offset The 32-bit aligned offset of the first register.
+* @param[in] size The size of the range in bytes, a multiple of 4.  Ranges must not overlap.
+*
+* @return 0 if the range is added; -1 if the handle is invalid.
+*/
+int fpga_shadow_add_range(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t size);
+
+/**
+* @brief The function reads a 32-bit register through the register shadow.
+*
+* fpga_shadow_read_64() is provided in the same way.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open().
+* @param[in] offset The address offset from the base address of the MMIO interface.
+*
+* @return The shadowed value if it is known; otherwise, the value read from the device.
+*/
+uint32_t fpga_shadow_read_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset);
+
+/**
+* @brief The function writes a 32-bit register and updates the register shadow.
+*
+* fpga_shadow_write_64() is provided in the same way.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open().
+* @param[in] offset The address offset from the base address of the MMIO interface.
+* @param[in] value The value to write to the specified address.
+*/
+void fpga_shadow_write_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t value);
+
+/**
+* @brief The function clears and sets bits of a 32-bit register.
+*
+* The register is written with (current value & ~clear) | set.  When the current value is known by the register shadow,
+* only the write reaches the device.  fpga_rmw_64() is provided in the same way.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open().
+* @param[in] offset The address offset from the base address of the MMIO interface.
+* @param[in] clear The bits to clear.
+* @param[in] set The bits to set.
+*
+* @return The value written.
+*/
+uint32_t fpga_rmw_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t clear, uint32_t set);
+
+/**
+* @brief The function forgets all shadowed values of the MMIO interface.  The next accesses read the device again.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open().
+*
+* @return 0 on success; -1 if the handle is invalid.
+*/
+int fpga_shadow_invalidate(FPGA_MMIO_INTERFACE_HANDLE handle);
+
+/**
+* @brief The function reloads all shadowed registers of the MMIO interface from the device.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open().
+*
+* @return 0 on success; -1 if the handle is invalid.
+*/
+int fpga_shadow_refresh(FPGA_MMIO_INTERFACE_HANDLE handle);
+
+/**
+* @brief The function returns the register shadow statistics of the MMIO interface.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open().
+* @param[out] stats The number of reads issued, reads avoided and writes issued through the shadow functions.
+*
+* @return 0 on success; -1 if the handle is invalid or stats is NULL.
+*/
+int fpga_shadow_get_stats(FPGA_MMIO_INTERFACE_HANDLE handle, FPGA_SHADOW_STATS *stats);
+
+/**
+* @brief The function returns the number of write-combined regions set up by the platform.
+*
+* Write-combined regions are requested at initialization, e.g. with the --wc-region=<offset>:<size> argument on the UIO and
+* devmem platforms.
+*
+* @note Use FPGA_PLATFORM_MAX_WC_REGIONS to determine the number of regions the platform supports.
+*
+* @return The number of write-combined regions.
+*/
+unsigned int fpga_get_num_of_wc_regions();
+
+/**
+* @brief The function opens a write-combined region as an MMIO interface.
+*
+* The returned handle is used with the MMIO access functions like the one returned by fpga_open().  Writes to the region may be
+* merged and reordered by the CPU until fpga_wc_flush() is called.  When the platform cannot map the region write-combined, the
+* region is mapped uncached and a warning is printed.
+*
+* @param[in] region The index of the region, which must be less than fpga_get_num_of_wc_regions().
+*
+* @return The handle to the interface of the region; -1 if the region is invalid or already opened.
+*/
+FPGA_MMIO_INTERFACE_HANDLE fpga_open_wc(unsigned int region);
+
+/**
+* @brief The function closes a write-combined region opened with fpga_open_wc().
+*
+* @param[in] region The index of the region.
+*/
+void fpga_close_wc(unsigned int region);
+
+/**
+* @brief The function drains the pending write-combined stores to the device.
+*
+* Call this after a burst of writes to a write-combined region, before any access that depends on the data having reached
+* the device, e.g. a doorbell write to an uncached interface.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open_wc().
+*/
+void fpga_wc_flush(FPGA_MMIO_INTERFACE_HANDLE handle);
+
+/**
+* @brief The function resolves an opened MMIO interface into a fast handle.
+*
+* The fast handle carries the base address of the interface by value, so the fpga_fast_read_N() and fpga_fast_write_N()
+* functions compile down to a single access at base plus offset, without looking the interface up on every call.  Use it
+* in tight polling and streaming loops.  The fast handle stays valid until the interface is closed.
+*
+* @note The fast accessors do not check the offset; keep it within FPGA_MMIO_FAST_HANDLE::span.
+*
+* @param[in] handle The handle to the targeted MMIO interface.  Obtained with fpga_open() or fpga_open_wc().
+*
+* @return The fast handle; its base is NULL if the handle is invalid or not opened.
+*/
+FPGA_MMIO_FAST_HANDLE fpga_open_fast(FPGA_MMIO_INTERFACE_HANDLE handle);
+
+/**
+* @brief The function provides the 32-bit MMIO read access through a fast handle.
+*
+* fpga_fast_read_8(), fpga_fast_read_16(), fpga_fast_read_64() and fpga_fast_read_512() are provided in the same way and
+* behave like fpga_read_8(), fpga_read_16(), fpga_read_64() and fpga_read_512().
+*
+* @param[in] fast The fast handle obtained with fpga_open_fast().
+* @param[in] offset The address offset from the base address of the MMIO interface.
+*
+* @return The value read from the specified address.
+*/
+uint32_t fpga_fast_read_32(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset);
+
+/**
+* @brief The function provides the 32-bit MMIO write access through a fast handle.
+*
+* fpga_fast_write_8(), fpga_fast_write_16(), fpga_fast_write_64() and fpga_fast_write_512() are provided in the same way
+* and behave like fpga_write_8(), fpga_write_16(), fpga_write_64() and fpga_write_512().
+*
+* @param[in] fast The fast handle obtained with fpga_open_fast().
+* @param[in] offset The address offset from the base address of the MMIO interface.
+* @param[in] value The value to write to the specified address.
+*/
+void fpga_fast_write_32(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset, uint32_t value);
+
 
 
 /** @} */ // end of mmio_rw
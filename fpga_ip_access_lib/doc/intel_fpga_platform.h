@@ -79,6 +79,8 @@
 #define FPGA_PLATFORM_HAS_NATIVE_MMIO_READ_512
 /// @brief This is a macro reporting whether the platform support 512-bit write natively
 #define FPGA_PLATFORM_HAS_NATIVE_MMIO_WRITE_512
+/// @brief This is a macro reporting the maximum number of write-combined regions, see fpga_get_num_of_wc_regions()
+#define FPGA_PLATFORM_MAX_WC_REGIONS
 
 /** @}*/ // end of mmio_capability
 
@@ -177,6 +179,71 @@ typedef struct
     int                          dfh_parent;        //!< Index to the FPGA_INTERFACE_INFO of the parent; -1 if there is no parent
 } FPGA_INTERFACE_INFO;
 
+/**
+* @brief MMIO batch operation type used by fpga_mmio_batch()
+* @note This type name is portable among all FPGA IP Access API libraries for different  platforms.
+*/
+typedef enum
+{
+    FPGA_MMIO_BATCH_WRITE,          //!< Write value to the offset
+    FPGA_MMIO_BATCH_READ            //!< Read from the offset into ptr
+} FPGA_MMIO_BATCH_OP;
+
+/**
+* @brief MMIO batch descriptor used by fpga_mmio_batch()
+* @note This type name is portable among all FPGA IP Access API libraries for different  platforms.
+*/
+typedef struct
+{
+    FPGA_MMIO_BATCH_OP           op;            //!< Read or write
+    uint32_t                     width;         //!< Access width in bits: 8, 16, 32 or 64
+    uint32_t                     offset;        //!< Byte offset from the base address of the MMIO interface
+    union
+    {
+        uint64_t                 value;         //!< Value to write for FPGA_MMIO_BATCH_WRITE
+        void                     *ptr;          //!< Destination of the width-sized value for FPGA_MMIO_BATCH_READ
+    };
+} FPGA_MMIO_BATCH_DESC;
+
+/// @brief This is a flag in FPGA_MMIO_FAST_HANDLE::flags reporting that the interface is mapped write-combined
+#define FPGA_MMIO_FAST_HANDLE_WRITE_COMBINING  (1<<0)
+
+/// @brief This is a flag in FPGA_MMIO_FAST_HANDLE::flags reporting that 64-bit accesses are split into two 32-bit accesses
+#define FPGA_MMIO_FAST_HANDLE_EMULATE_64BIT    (1<<1)
+
+/**
+* @brief Pre-resolved MMIO interface returned by fpga_open_fast()
+* @note This type name is portable among all FPGA IP Access API libraries for different  platforms.  The members are platform specific.
+*/
+typedef struct
+{
+    volatile uint8_t             *base;         //!< Base address of the MMIO interface; NULL if the handle is invalid
+    size_t                       span;          //!< Number of bytes accessible from base
+    uint32_t                     flags;         //!< FPGA_MMIO_FAST_HANDLE_* flags
+} FPGA_MMIO_FAST_HANDLE;
+
+/**
+* @brief Polling policy used by fpga_poll_until()
+* @note This type name is portable among all FPGA IP Access API libraries for different  platforms.
+*/
+typedef enum
+{
+    FPGA_POLL_SPIN,                             //!< Spin with a CPU relax hint between reads until the timeout
+    FPGA_POLL_BACKOFF,                          //!< Spin briefly, then wait exponentially longer between reads and yield the CPU
+    FPGA_POLL_SLEEP                             //!< Spin briefly, then sleep exponentially longer between reads
+} FPGA_POLL_POLICY;
+
+/**
+* @brief Polling statistics returned by fpga_poll_until()
+* @note This type name is portable among all FPGA IP Access API libraries for different  platforms.
+*/
+typedef struct
+{
+    uint64_t                     elapsed_ns;    //!< Time spent polling
+    uint64_t                     read_count;    //!< Number of register reads issued
+    uint64_t                     value;         //!< Last value read
+} FPGA_POLL_RESULT;
+
 /**
 * @brief Physical memory address value type
 * @note This type name is portable among all FPGA IP Access API libraries for different  platforms.  The typedef definition is platform specific.
@@ -159,6 +159,18 @@ void fpga_platform_register_runtime_exception_handler(FPGA_RUNTIME_EXCEPTION_HAN
 *     }
 * 
 * @endcode
+*
+* @note Concurrency model.
+* - fpga_platform_init() and fpga_platform_cleanup() must not run concurrently with any other function.
+* - fpga_get_num_of_interfaces(), fpga_get_interface_at(), the find functions, fpga_get_parameter() and the open and close
+*   functions are safe to call from any thread.
+*   Opening is atomic: when several threads open the same interface, exactly one of them obtains the handle.
+* - An MMIO access is a single transaction and is safe from any thread, but the library does not serialize the accesses of
+*   different threads.  Guard a sequence of accesses that must not interleave with another thread, e.g. an index/data register pair,
+*   a read-modify-write with fpga_rmw_32(), or the register shadow functions, with fpga_lock() and fpga_unlock() on the interface.
+*   The lock is optional and costs nothing when it is not used.
+* - fpga_set_64bit_emulation() and fpga_shadow_add_range() configure the interface; call them before the interface is shared.
+*
 * @{
 */
 
@@ -183,9 +195,131 @@ unsigned int fpga_get_num_of_interfaces();
 */
 bool fpga_get_interface_at(unsigned int index, FPGA_INTERFACE_INFO *info);
 
+/**
+* @brief The function gives read access to the information of a specific interface without copying it.
+*
+* With the DFL parameter views enabled (--dfl-param-views), the parameter data of the interface point into the host
+* copy of the DFL ROM, so nothing is copied after the scan.
+*
+* @param[in] index The interface index.
+* @return the interface information, or NULL if the index is wrong or the interface was removed by fpga_dfl_rescan().
+*         The pointer stays valid until the next fpga_dfl_rescan() or fpga_platform_cleanup(); the parameters it
+*         points to stay valid until fpga_platform_cleanup().
+*/
+const FPGA_INTERFACE_INFO *fpga_interface_view(unsigned int index);
+
+/**
+* @brief The function finds the interface with the specified GUID and instance ID.
+*
+* The lookup uses an index built when the interfaces are discovered, so it does not depend on the number of interfaces
+* and does not copy the interface information.
+*
+* @param[in] guid The GUID of the interface.
+* @param[in] instance_id The instance ID of the interface.
+* @return the lowest interface index matching both, to be passed to fpga_get_interface_at() or fpga_open(); -1 if there is none.
+*/
+int fpga_find_interface(const FPGA_INTERFACE_GUID *guid, uint16_t instance_id);
+
+/**
+* @brief The function finds all the interfaces with the specified GUID.
+*
+* @param[in] guid The GUID of the interfaces.
+* @param[out] indices The buffer receiving the interface indices in ascending order; may be NULL to count the interfaces only.
+* @param[in] max_indices The number of indices the buffer can hold.
+* @return the number of interfaces with the GUID, which is larger than max_indices when the buffer is too small.
+*/
+unsigned int fpga_find_all_by_guid(const FPGA_INTERFACE_GUID *guid, unsigned int *indices, unsigned int max_indices);
+
+/**
+* @brief The function finds all the interfaces with the specified group ID.
+*
+* @param[in] group_id The group ID of the interfaces.
+* @param[out] indices The buffer receiving the interface indices in ascending order; may be NULL to count the interfaces only.
+* @param[in] max_indices The number of indices the buffer can hold.
+* @return the number of interfaces in the group, which is larger than max_indices when the buffer is too small.
+*/
+unsigned int fpga_get_group_members(uint16_t group_id, unsigned int *indices, unsigned int max_indices);
+
+/**
+* @brief The function lists the interfaces found through the DFL branches of an interface, i.e. whose dfh_parent is the index.
+*
+* The interface tree is indexed when the interfaces are discovered, so the cost depends on the number of children only.
+*
+* @param[in] index The interface index.
+* @param[out] indices The buffer receiving the interface indices in ascending order; may be NULL to count the children only.
+* @param[in] max_indices The number of indices the buffer can hold.
+* @return the number of children, which is larger than max_indices when the buffer is too small; 0 if the index is wrong.
+*/
+unsigned int fpga_get_children(unsigned int index, unsigned int *indices, unsigned int max_indices);
+
+/**
+* @brief The function walks the interface tree depth-first, each interface before its children.
+*
+* Start with index -1 and pass the returned index back until -1 is returned:
+* @code
+* for (int i = fpga_get_next_in_tree(root, -1); i >= 0; i = fpga_get_next_in_tree(root, i))
+* @endcode
+*
+* @param[in] root The interface whose subtree is walked, itself included; -1 walks all the interfaces.
+* @param[in] index The interface returned by the previous call, or -1 to start.
+* @return the next interface index in the subtree; -1 at the end or if an index is wrong.
+*/
+int fpga_get_next_in_tree(int root, int index);
+
+/**
+* @brief The function finds a DFL parameter of an interface.
+*
+* The parameters are sorted by parameter ID when the interfaces are discovered, so the lookup is a binary search and
+* does not copy the interface information.
+*
+* @param[in] index The interface index.
+* @param[in] param_id The parameter ID.
+* @param[in] version_min The lowest acceptable parameter version.
+* @return the parameter with the ID and the highest version when that version is >= version_min; NULL otherwise or if the
+*         index is wrong.  The parameter stays valid until fpga_platform_cleanup().
+*/
+const FPGA_INTERFACE_PARAMETER *fpga_get_parameter(unsigned int index, uint16_t param_id, uint16_t version_min);
+
+/**
+* @brief The function walks the DFL under an interface again, e.g. after a partial reconfiguration of the region it describes.
+*
+* Only the DFH of the interface and its branches are read.  An interface found again at the same DFH address keeps its
+* index, open handle and ISR; its GUID, IDs, parameters and base address are updated when they differ.  An interface
+* not found any more stays in the table as removed, so the other indices do not move: it cannot be found or opened,
+* but a handle opened before stays valid until it is closed.  A new interface is appended to the table.
+*
+* @pre No other thread uses the interface table during the rescan.  The interrupts of all the interfaces are disabled
+*      with fpga_disable_interrupt() and no ISR is running: the UIO interrupt thread reads the table while they are
+*      enabled, and the table is reallocated when an interface is added.
+*
+* @param[in] parent_index The index of the DFL interface to rescan.
+* @param[in] callback Called once for each added, removed or changed interface; may be NULL.
+* @param[in] context Passed to the callback.
+* @return the number of added, removed and changed interfaces; -1 if the index is wrong or its DFH cannot be walked.
+*         The parameters replaced by the rescan stay valid until fpga_platform_cleanup().
+*/
+int fpga_dfl_rescan(unsigned int parent_index, FPGA_DFL_RESCAN_CALLBACK callback, void *context);
+
+/**
+* @brief The function writes the interface table to a file, e.g. for an inventory or to build offline test data.
+*
+* All the interfaces are written in index order with their GUID, instance ID, group ID, parent index, base address and
+* parameters.  The base addresses are decoded as by the platform, e.g. into offsets from the start of the UIO map.
+* FPGA_DFL_EXPORT_BINARY writes the image described in intel_fpga_api_cmn_dfl_export.h; FPGA_DFL_EXPORT_JSON writes a
+* JSON document with the same content, where GUIDs, addresses and parameter data are hexadecimal strings.
+* The file is replaced atomically.  Not available on Zephyr.
+*
+* @param[in] path The path of the file.
+* @param[in] format FPGA_DFL_EXPORT_BINARY or FPGA_DFL_EXPORT_JSON.
+* @return 0 on success; -1 if the file cannot be written.
+*/
+int fpga_dfl_export(const char *path, FPGA_DFL_EXPORT_FORMAT format);
+
 /**
 * @brief The function claims the exclusive usage of the interface.
 * 
+* The claim is atomic, so only one of the threads opening the same interface concurrently obtains the handle.
+*
 * @warning This claim applies within the process space only.
 *
 * @param[in] index The interface index.
@@ -220,6 +354,33 @@ FPGA_INTERRUPT_HANDLE fpga_interrupt_open(unsigned int index);
 */
 void fpga_interrupt_close(unsigned int index);
 
+/**
+* @brief The function takes the lock of the interface, spinning until it is available.
+*
+* The lock is fair: waiters are granted the lock in arrival order.  Hold it for a short sequence of register accesses only, and
+* do not call blocking functions while holding it.  The lock is not recursive.
+*
+* @param[in] handle The handle to the targeted MMIO interface.
+* @return 0 on success; -1 if the handle is invalid.
+*/
+int fpga_lock(FPGA_MMIO_INTERFACE_HANDLE handle);
+
+/**
+* @brief The function takes the lock of the interface if it is available, without waiting.
+*
+* @param[in] handle The handle to the targeted MMIO interface.
+* @return 0 if the lock is taken; 1 if the lock is held by another caller; -1 if the handle is invalid.
+*/
+int fpga_trylock(FPGA_MMIO_INTERFACE_HANDLE handle);
+
+/**
+* @brief The function releases the lock taken with fpga_lock() or fpga_trylock().
+*
+* @param[in] handle The handle to the targeted MMIO interface.
+* @return 0 on success; -1 if the handle is invalid.
+*/
+int fpga_unlock(FPGA_MMIO_INTERFACE_HANDLE handle);
+
 
 /** @} */ // end of discovery
 
@@ -31,6 +31,8 @@
 #include <stdarg.h>
 #include "intel_fpga_platform_uio.h"
 #include "intel_fpga_api_cmn_inf.h"
+#include "intel_fpga_api_cmn_arch.h"
+#include "intel_fpga_api_cmn_wide.h"
 
 
 #ifdef __cplusplus
@@ -39,68 +41,191 @@ extern "C" {
 
 static inline void *fpga_uio_get_base_address(FPGA_MMIO_INTERFACE_HANDLE handle)
 {
-    return common_fpga_interface_info_vec_at(handle)->base_address;
+    return (void *)common_fpga_interface_hot_at(handle)->base;
 }
 
-static inline uint8_t fpga_read_8(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+// 64-bit accesses are split into two 32-bit accesses for the interfaces behind a bridge that requires it, e.g. the
+// Intel FPGA PCIe Memory Mapped Bridge IP.  The flag is constant per interface, so the branch predicts well.
+static inline bool fpga_uio_is_64bit_emulated(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+#ifndef FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT
+    return __builtin_expect(common_fpga_interface_hot_at(handle)->emulate_64bit, 0);
+#else
+    return true;
+#endif
+}
+
+static inline bool fpga_uio_fast_is_64bit_emulated(FPGA_MMIO_FAST_HANDLE fast)
+{
+#ifndef FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT
+    return __builtin_expect((fast.flags & FPGA_MMIO_FAST_HANDLE_EMULATE_64BIT) != 0, 0);
+#else
+    return true;
+#endif
+}
+
+static inline uint8_t fpga_read_8_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
 {
     return *((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset);
 }
 
-static inline void fpga_write_8(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint8_t value)
+static inline void fpga_write_8_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint8_t value)
 {
     *((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset) = value;
 }
 
-static inline uint16_t fpga_read_16(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+static inline uint16_t fpga_read_16_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
 {
     return *((volatile uint16_t *)((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset));
 }
 
-static inline void fpga_write_16(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint16_t value)
+static inline void fpga_write_16_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint16_t value)
 {
     *((volatile uint16_t *)((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset)) = value;
 }
 
-static inline uint32_t fpga_read_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+static inline uint32_t fpga_read_32_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
 {
     return *((volatile uint32_t *)((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset));
 }
 
-static inline void fpga_write_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t value)
+static inline void fpga_write_32_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t value)
 {
     *((volatile uint32_t *)((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset)) = value;
 }
 
+static inline uint64_t fpga_read_64_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+{
+    if (!fpga_uio_is_64bit_emulated(handle))
+    {
+        return *((volatile uint64_t *)((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset));
+    }
+    else
+    {
+        // This emulation is needed when Intel FPGA PCIe Memory Mapped Bridge IP is used to implement the PCIe function.
+        // Little-endian system is assumed.
+        uint64_t data = fpga_read_32_relaxed(handle, offset);
+        data |= (uint64_t)fpga_read_32_relaxed(handle, offset + 4) << 32;
+
+        return data;
+    }
+}
+
+static inline void fpga_write_64_relaxed(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint64_t value)
+{
+    if (!fpga_uio_is_64bit_emulated(handle))
+    {
+        *((volatile uint64_t *)((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset)) = value;
+    }
+    else
+    {
+        // This emulation is needed when Intel FPGA PCIe Memory Mapped Bridge IP is used to implement the PCIe function.
+        // Little-endian system is assumed.
+        fpga_write_32_relaxed(handle, offset, (uint32_t)value);
+        fpga_write_32_relaxed(handle, offset + 4, (uint32_t)(value >> 32));
+    }
+}
+
+// Ordered accessors: a write is not reordered ahead of prior memory stores, e.g. to a DMA buffer, and a read completes
+// before later memory loads.  The _relaxed accessors above only guarantee the program order of MMIO accesses to the same
+// interface; use them with fpga_mmio_wmb()/fpga_mmio_rmb()/fpga_mmio_mb() to batch accesses.
+static inline uint8_t fpga_read_8(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+{
+    uint8_t value = fpga_read_8_relaxed(handle, offset);
+
+    common_mmio_after_read();
+
+    return value;
+}
+
+static inline void fpga_write_8(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint8_t value)
+{
+    common_mmio_before_write();
+    fpga_write_8_relaxed(handle, offset, value);
+}
+
+static inline uint16_t fpga_read_16(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+{
+    uint16_t value = fpga_read_16_relaxed(handle, offset);
+
+    common_mmio_after_read();
+
+    return value;
+}
+
+static inline void fpga_write_16(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint16_t value)
+{
+    common_mmio_before_write();
+    fpga_write_16_relaxed(handle, offset, value);
+}
+
+static inline uint32_t fpga_read_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
+{
+    uint32_t value = fpga_read_32_relaxed(handle, offset);
+
+    common_mmio_after_read();
+
+    return value;
+}
+
+static inline void fpga_write_32(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t value)
+{
+    common_mmio_before_write();
+    fpga_write_32_relaxed(handle, offset, value);
+}
+
 static inline uint64_t fpga_read_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset)
 {
-#ifndef FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT
-    return *((volatile uint64_t *)((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset));
-#else
-    // This emulation is needed when Intel FPGA PCIe Memory Mapped Bridge IP is used to implement the PCIe function.
-    // Little-endian system is assumed.
-    uint64_t data = fpga_read_32(handle, offset);
-    data |= (uint64_t)fpga_read_32(handle, offset + 4) << 32;
+    uint64_t value = fpga_read_64_relaxed(handle, offset);
 
-    return data;
-#endif
+    common_mmio_after_read();
+
+    return value;
 }
 
 static inline void fpga_write_64(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint64_t value)
+{
+    common_mmio_before_write();
+    fpga_write_64_relaxed(handle, offset, value);
+}
+
+static inline void fpga_mmio_wmb()
+{
+    common_mmio_wmb();
+}
+
+static inline void fpga_mmio_rmb()
+{
+    common_mmio_rmb();
+}
+
+static inline void fpga_mmio_mb()
+{
+    common_mmio_mb();
+}
+
+// Push the posted writes to the interface out to the device by reading it back.
+static inline void fpga_mmio_flush(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    common_mmio_wmb();
+    (void)fpga_read_32_relaxed(handle, 0);
+    common_mmio_rmb();
+}
+
+static inline bool fpga_has_native_mmio_512()
 {
 #ifndef FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT
-    *((volatile uint64_t *)((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset)) = value;
+    return common_mmio_wide_path() == COMMON_MMIO_WIDE_PATH_AVX512;
 #else
-    // This emulation is needed when Intel FPGA PCIe Memory Mapped Bridge IP is used to implement the PCIe function.
-    // Little-endian system is assumed.
-    fpga_write_32(handle, offset, (uint32_t)value);
-    fpga_write_32(handle, offset + 4, (uint32_t)(value >> 32));
+    return false;
 #endif
 }
 
 static inline void fpga_read_512(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint8_t *value)
 {
     int     i;
+    if (!fpga_uio_is_64bit_emulated(handle) && common_mmio_read_512((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset, value))
+        return;
     for(i = 0; i < (512/64); ++i)
     {
         *((volatile uint64_t *)value) = fpga_read_64(handle, offset);
@@ -112,6 +237,8 @@ static inline void fpga_read_512(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t off
 static inline void fpga_write_512(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint8_t *value)
 {
     int     i;
+    if (!fpga_uio_is_64bit_emulated(handle) && common_mmio_write_512((volatile uint8_t *)fpga_uio_get_base_address(handle) + offset, value))
+        return;
     for(i = 0; i < (512/64); ++i)
     {
         fpga_write_64(handle, offset, *((volatile uint64_t *)value));
@@ -120,10 +247,133 @@ static inline void fpga_write_512(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t of
     }
 }
 
+// Fast handle accessors: the base address is carried by value, so loops compile down to a single base+offset access.
+static inline uint8_t fpga_fast_read_8(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset)
+{
+    uint8_t value = *(fast.base + offset);
+
+    common_mmio_after_read();
+
+    return value;
+}
+
+static inline void fpga_fast_write_8(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset, uint8_t value)
+{
+    common_mmio_before_write();
+    *(fast.base + offset) = value;
+}
+
+static inline uint16_t fpga_fast_read_16(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset)
+{
+    uint16_t value = *((volatile uint16_t *)(fast.base + offset));
+
+    common_mmio_after_read();
+
+    return value;
+}
+
+static inline void fpga_fast_write_16(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset, uint16_t value)
+{
+    common_mmio_before_write();
+    *((volatile uint16_t *)(fast.base + offset)) = value;
+}
+
+static inline uint32_t fpga_fast_read_32(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset)
+{
+    uint32_t value = *((volatile uint32_t *)(fast.base + offset));
+
+    common_mmio_after_read();
+
+    return value;
+}
+
+static inline void fpga_fast_write_32(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset, uint32_t value)
+{
+    common_mmio_before_write();
+    *((volatile uint32_t *)(fast.base + offset)) = value;
+}
+
+static inline uint64_t fpga_fast_read_64(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset)
+{
+    if (!fpga_uio_fast_is_64bit_emulated(fast))
+    {
+        uint64_t value = *((volatile uint64_t *)(fast.base + offset));
+
+        common_mmio_after_read();
+
+        return value;
+    }
+    else
+    {
+        uint64_t data = fpga_fast_read_32(fast, offset);
+        data |= (uint64_t)fpga_fast_read_32(fast, offset + 4) << 32;
+
+        return data;
+    }
+}
+
+static inline void fpga_fast_write_64(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset, uint64_t value)
+{
+    if (!fpga_uio_fast_is_64bit_emulated(fast))
+    {
+        common_mmio_before_write();
+        *((volatile uint64_t *)(fast.base + offset)) = value;
+    }
+    else
+    {
+        fpga_fast_write_32(fast, offset, (uint32_t)value);
+        fpga_fast_write_32(fast, offset + 4, (uint32_t)(value >> 32));
+    }
+}
+
+static inline void fpga_fast_read_512(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset, uint8_t *value)
+{
+    int     i;
+    if (!fpga_uio_fast_is_64bit_emulated(fast) && common_mmio_read_512(fast.base + offset, value))
+        return;
+    for(i = 0; i < (512/64); ++i)
+    {
+        *((volatile uint64_t *)value) = fpga_fast_read_64(fast, offset);
+        value += 64/8;
+        offset += 64/8;
+    }
+}
+
+static inline void fpga_fast_write_512(FPGA_MMIO_FAST_HANDLE fast, uint32_t offset, uint8_t *value)
+{
+    int     i;
+    if (!fpga_uio_fast_is_64bit_emulated(fast) && common_mmio_write_512(fast.base + offset, value))
+        return;
+    for(i = 0; i < (512/64); ++i)
+    {
+        fpga_fast_write_64(fast, offset, *((volatile uint64_t *)value));
+        value += 64/8;
+        offset += 64/8;
+    }
+}
+
+// Drain the write-combining buffers so that the preceding writes through a write-combined handle are posted.
+static inline void fpga_wc_flush(FPGA_MMIO_INTERFACE_HANDLE handle)
+{
+    (void)handle;
+    common_mmio_wmb();
+}
+
+unsigned int fpga_get_num_of_wc_regions();
+FPGA_MMIO_INTERFACE_HANDLE fpga_open_wc(unsigned int region);
+void fpga_close_wc(unsigned int region);
+FPGA_MMIO_FAST_HANDLE fpga_open_fast(FPGA_MMIO_INTERFACE_HANDLE handle);
+
 void *fpga_malloc(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t size);
 void fpga_free(FPGA_MMIO_INTERFACE_HANDLE handle, void *address);
 FPGA_PLATFORM_PHYSICAL_MEM_ADDR_TYPE fpga_get_physical_address(void *address);
 
+int fpga_mmio_batch(FPGA_MMIO_INTERFACE_HANDLE handle, const FPGA_MMIO_BATCH_DESC *desc, size_t count);
+int fpga_read_block(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, void *dst, size_t len);
+int fpga_write_block(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, const void *src, size_t len);
+int fpga_poll_until(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t width, uint64_t mask, uint64_t value,
+                    uint64_t timeout_ns, FPGA_POLL_POLICY policy, FPGA_POLL_RESULT *result);
+
 int fpga_register_isr(FPGA_INTERRUPT_HANDLE handle, FPGA_ISR isr, void *isr_context);
 int fpga_enable_interrupt(FPGA_INTERRUPT_HANDLE handle);
 int fpga_disable_interrupt(FPGA_INTERRUPT_HANDLE handle);
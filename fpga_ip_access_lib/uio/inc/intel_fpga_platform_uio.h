@@ -47,8 +47,16 @@ extern "C" {
 #define FPGA_PLATFORM_HAS_NATIVE_MMIO_WRITE_32
 #define FPGA_PLATFORM_HAS_NATIVE_MMIO_READ_64
 #define FPGA_PLATFORM_HAS_NATIVE_MMIO_WRITE_64
+// 512-bit access is a single transaction when built for AVX-512; fpga_has_native_mmio_512() reports it at run-time.
+#if defined(__AVX512F__) && !defined(FPGA_PLATFORM_FORCE_64BIT_MMIO_EMULATION_WITH_32BIT)
+#define FPGA_PLATFORM_HAS_NATIVE_MMIO_READ_512
+#define FPGA_PLATFORM_HAS_NATIVE_MMIO_WRITE_512
+#endif
 #define FPGA_PLATFORM_IS_ISR_CALLED_IN_THREAD
 
+// Maximum number of --wc-region arguments
+#define FPGA_PLATFORM_MAX_WC_REGIONS       8
+
 // Interrupt Thread Status Flag Definition
 #define FPGA_PLATFORM_INT_THREAD_EXIT      (1<<0)
 
@@ -92,8 +100,60 @@ typedef struct
     bool                         interrupt_enable;
     FPGA_ISR                     isr_callback;
     void                         *isr_context;
+    bool                         write_combining;   // Set for the interfaces exposing --wc-region windows
+    size_t                       address_span;      // Bytes mapped from base_address; bounds FPGA_MMIO_FAST_HANDLE
+    void                         *shadow;           // Register shadow created by fpga_shadow_add_range(); NULL if unused
+    bool                         emulate_64bit;     // Split 64-bit accesses into two 32-bit accesses; see fpga_set_64bit_emulation()
+    void                         *dfh_address;      // DFH describing the interface; NULL if not discovered from a DFL
+    uint32_t                     *param_order;      // Parameter positions sorted by param_id, highest version first; see fpga_get_parameter()
+    bool                         is_removed;        // Set by fpga_dfl_rescan() when the DFH is gone; the index is kept but cannot be opened
+    uint32_t                     lock_ticket;       // Next ticket of the fpga_lock() ticket lock
+    uint32_t                     lock_serving;      // Ticket holding the fpga_lock() ticket lock
 } FPGA_INTERFACE_INFO;
 
+typedef enum
+{
+    FPGA_MMIO_BATCH_WRITE,
+    FPGA_MMIO_BATCH_READ
+} FPGA_MMIO_BATCH_OP;
+
+typedef struct
+{
+    FPGA_MMIO_BATCH_OP           op;            //!< Read or write
+    uint32_t                     width;         //!< Access width in bits: 8, 16, 32 or 64
+    uint32_t                     offset;        //!< Byte offset from the base address of the MMIO interface
+    union
+    {
+        uint64_t                 value;         //!< Value to write for FPGA_MMIO_BATCH_WRITE
+        void                     *ptr;          //!< Destination of the width-sized value for FPGA_MMIO_BATCH_READ
+    };
+} FPGA_MMIO_BATCH_DESC;
+
+// FPGA_MMIO_FAST_HANDLE flags
+#define FPGA_MMIO_FAST_HANDLE_WRITE_COMBINING  (1<<0)
+#define FPGA_MMIO_FAST_HANDLE_EMULATE_64BIT    (1<<1)
+
+typedef struct
+{
+    volatile uint8_t             *base;         //!< Base address of the MMIO interface; NULL if the handle is invalid
+    size_t                       span;          //!< Number of bytes accessible from base
+    uint32_t                     flags;         //!< FPGA_MMIO_FAST_HANDLE_* flags
+} FPGA_MMIO_FAST_HANDLE;
+
+typedef enum
+{
+    FPGA_POLL_SPIN,                             //!< Spin with a CPU relax hint between reads until the timeout
+    FPGA_POLL_BACKOFF,                          //!< Spin briefly, then wait exponentially longer between reads and yield the CPU
+    FPGA_POLL_SLEEP                             //!< Spin briefly, then sleep exponentially longer between reads
+} FPGA_POLL_POLICY;
+
+typedef struct
+{
+    uint64_t                     elapsed_ns;    //!< Time spent polling
+    uint64_t                     read_count;    //!< Number of register reads issued
+    uint64_t                     value;         //!< Last value read
+} FPGA_POLL_RESULT;
+
 typedef void * FPGA_PLATFORM_PHYSICAL_MEM_ADDR_TYPE;
 
 // Platform specific internal API
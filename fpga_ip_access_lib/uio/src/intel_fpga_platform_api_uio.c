@@ -55,6 +55,15 @@ static char *s_uio_drv_path = "/dev/uio0";
 static size_t s_uio_addr_span = 0;
 static size_t s_dfl_entry_addr = 0;
 static int s_uio_single_component_mode = 1;
+static int s_uio_emulate_64bit = 0;
+static bool s_uio_dfl_rom_snapshot = false;
+static size_t s_uio_dfl_rom_snapshot_size = 0;   // 0 bounds the snapshot by the DFH list
+static bool s_uio_dfl_param_views = false;
+static char *s_uio_dfl_cache_path = NULL;
+static size_t s_uio_dfl_max_depth = 0;          // 0 keeps the default DFL scan limit
+static size_t s_uio_dfl_max_interfaces = 0;
+static size_t s_uio_dfl_scan_workers = 0;
+static size_t s_uio_dfl_mmio_access_param_id = 0;
 static size_t s_uio_start_addr = 0;
 static size_t s_uio_inThread_timeout = 0;
 
@@ -64,16 +73,42 @@ static pthread_t s_intThread_id = 0;
 static pthread_rwlock_t s_intLock;
 static int s_intFlags = 0;
 
+#ifndef UIO_UNIT_TEST_SW_MODEL_MODE
+static const uint64_t MASK_4K_ADDR = ~(4*1024-1);
+#endif
+
+typedef struct
+{
+    size_t          offset;         // Region offset within the UIO map
+    size_t          size;
+    void            *mmap_ptr;      // Write-combined mapping; NULL if the region falls back to the uncached mapping
+    size_t          mmap_size;
+    unsigned int    index;          // Index of the interface exposing the region
+} UIO_WC_REGION;
+
+static UIO_WC_REGION s_uio_wc_regions[FPGA_PLATFORM_MAX_WC_REGIONS];
+static unsigned int s_uio_wc_region_count = 0;
+static bool s_uio_wc_args_valid = true;
+static int s_uio_wc_drv_handle = -1;
+
 static void uio_parse_args(unsigned int argc, const char *argv[]);
 static long uio_parse_integer_arg(const char *name);
+static void uio_parse_wc_region_arg();
 static void uio_update_based_on_sysfs();
+static bool uio_get_driver_index(uint32_t *index);
 static void uio_get_sysfs_map_path(char *path, int path_buf_size);
+#ifndef UIO_UNIT_TEST_SW_MODEL_MODE
+static bool uio_get_sysfs_wc_resource_path(char *path, int path_buf_size, size_t *bar_offset);
+#endif
 static uint64_t uio_get_sysfs_map_file_to_uint64(const char *path);
 static bool uio_validate_args();
 static void uio_print_configuration();
 static bool uio_open_driver();
 static bool uio_map_mmio();
 static bool uio_scan_interfaces();
+static void uio_update_address_spans();
+static bool uio_add_wc_interfaces();
+static void uio_unmap_wc_regions();
 static bool uio_create_interrupt_thread();
 static bool uio_create_unit_test_sw_model();
 
@@ -191,6 +226,13 @@ bool fpga_platform_init(unsigned int argc, const char *argv[])
     if (is_args_valid)
     {
         uio_print_configuration();
+        common_dfl_set_64bit_emulation(s_uio_emulate_64bit != 0);
+        common_dfl_set_rom_snapshot(s_uio_dfl_rom_snapshot, s_uio_dfl_rom_snapshot_size);
+        common_dfl_set_param_views(s_uio_dfl_param_views);
+        common_dfl_set_cache_path(s_uio_dfl_cache_path);
+        common_dfl_set_scan_limits(s_uio_dfl_max_depth, s_uio_dfl_max_interfaces);
+        common_dfl_set_scan_workers(s_uio_dfl_scan_workers);
+        common_dfl_set_mmio_access_param_id((uint16_t)s_uio_dfl_mmio_access_param_id);
 #ifndef UIO_UNIT_TEST_SW_MODEL_MODE
         if (uio_open_driver() == false)
             goto err_open;
@@ -200,9 +242,15 @@ bool fpga_platform_init(unsigned int argc, const char *argv[])
 
         if (uio_scan_interfaces() == false)
             goto err_scan;
+
+        if (uio_add_wc_interfaces() == false)
+            goto err_wc;
 #else
         if (uio_create_unit_test_sw_model() == false)
             goto err_open;
+
+        if (uio_add_wc_interfaces() == false)
+            goto err_wc;
 #endif
         ret = true;
     }
@@ -223,11 +271,19 @@ bool fpga_platform_init(unsigned int argc, const char *argv[])
     return ret;
 
 #ifndef UIO_UNIT_TEST_SW_MODEL_MODE
+err_wc:
+    uio_unmap_wc_regions();
+    common_fpga_interface_info_vec_resize(0);
+
 err_scan:
     munmap(s_uio_mmap_ptr, s_uio_addr_span);
 
 err_map:
     close(s_uio_drv_handle);
+#else
+err_wc:
+    free(common_fpga_interface_info_vec_at(0)->base_address);
+    common_fpga_interface_info_vec_resize(0);
 #endif
 
 err_open:
@@ -270,6 +326,8 @@ void fpga_platform_cleanup()
         }
     }
 
+    uio_unmap_wc_regions();
+
     if (s_uio_drv_handle >= 0)
     {
         close(s_uio_drv_handle);
@@ -280,6 +338,26 @@ void fpga_platform_cleanup()
     s_uio_start_addr = 0;
     s_uio_addr_span = 0;
     s_uio_single_component_mode = 0;
+    s_uio_wc_region_count = 0;
+    s_uio_wc_args_valid = true;
+    s_uio_emulate_64bit = 0;
+    common_dfl_set_64bit_emulation(false);
+    s_uio_dfl_rom_snapshot = false;
+    s_uio_dfl_rom_snapshot_size = 0;
+    common_dfl_set_rom_snapshot(false, 0);
+    s_uio_dfl_param_views = false;
+    common_dfl_set_param_views(false);
+    s_uio_dfl_cache_path = NULL;
+    common_dfl_set_cache_path(NULL);
+    s_uio_dfl_max_depth = 0;
+    s_uio_dfl_max_interfaces = 0;
+    common_dfl_set_scan_limits(0, 0);
+    s_uio_dfl_scan_workers = 0;
+    common_dfl_set_scan_workers(0);
+    s_uio_dfl_mmio_access_param_id = 0;
+    common_dfl_set_mmio_access_param_id(0);
+    common_dfl_set_address_range(NULL, 0);
+    common_dfl_set_base_addr_decoder(NULL);
 
     s_uio_drv_handle = -1;
     s_uio_mmap_ptr = NULL;
@@ -307,6 +385,15 @@ void uio_parse_args(unsigned int argc, const char *argv[])
             {"dfl-entry-address", required_argument, 0, 'w'},
             {"show-dbg-msg", no_argument, &g_common_show_dbg_msg, 'd'},
             {"single-component-mode", no_argument, &s_uio_single_component_mode, 'c'},
+            {"emulate-64bit", no_argument, &s_uio_emulate_64bit, 'e'},
+            {"dfl-rom-snapshot", optional_argument, 0, 'n'},
+            {"dfl-param-views", no_argument, 0, 'v'},
+            {"dfl-cache", required_argument, 0, 'k'},
+            {"dfl-max-depth", required_argument, 0, 'l'},
+            {"dfl-max-interfaces", required_argument, 0, 'i'},
+            {"dfl-scan-workers", required_argument, 0, 't'},
+            {"dfl-mmio-access-param", required_argument, 0, 'm'},
+            {"wc-region", required_argument, 0, 'r'},
             {0, 0, 0, 0}};
 
     int option_index = 0;
@@ -317,7 +404,7 @@ void uio_parse_args(unsigned int argc, const char *argv[])
 
     while (1)
     {
-        c = getopt_long(argc, (char *const *)argv, "p:a:w:s:dc", long_options, &option_index);
+        c = getopt_long(argc, (char *const *)argv, "p:a:w:s:dcr:en::vk:l:i:t:m:", long_options, &option_index);
 
         if (c == -1)
         {
@@ -341,6 +428,43 @@ void uio_parse_args(unsigned int argc, const char *argv[])
         case 'w':
             s_dfl_entry_addr = uio_parse_integer_arg("DFL entry address");
             break;
+
+        case 'r':
+            uio_parse_wc_region_arg();
+            break;
+
+        case 'e':
+            s_uio_emulate_64bit = 1;
+            break;
+
+        case 'n':
+            s_uio_dfl_rom_snapshot = true;
+            s_uio_dfl_rom_snapshot_size = optarg != NULL ? uio_parse_integer_arg("DFL ROM snapshot size") : 0;
+            break;
+
+        case 'v':
+            s_uio_dfl_param_views = true;
+            break;
+
+        case 'k':
+            s_uio_dfl_cache_path = optarg;
+            break;
+
+        case 'l':
+            s_uio_dfl_max_depth = uio_parse_integer_arg("DFL max depth");
+            break;
+
+        case 'i':
+            s_uio_dfl_max_interfaces = uio_parse_integer_arg("DFL max interfaces");
+            break;
+
+        case 't':
+            s_uio_dfl_scan_workers = uio_parse_integer_arg("DFL scan workers");
+            break;
+
+        case 'm':
+            s_uio_dfl_mmio_access_param_id = uio_parse_integer_arg("DFL MMIO access parameter ID");
+            break;
         }
     }
 }
@@ -417,6 +541,44 @@ long uio_parse_integer_arg(const char *name)
     return ret;
 }
 
+void uio_parse_wc_region_arg()
+{
+    char *endptr;
+    size_t offset;
+    size_t size;
+
+    if (s_uio_wc_region_count >= FPGA_PLATFORM_MAX_WC_REGIONS)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Too many write-combined regions. %s is ignored; maximum accepted is %d", optarg, FPGA_PLATFORM_MAX_WC_REGIONS);
+        s_uio_wc_args_valid = false;
+        return;
+    }
+
+    // <offset>:<size>
+    errno = 0;
+    offset = strtoul(optarg, &endptr, 0);
+    if (endptr == optarg || *endptr != ':' || errno == ERANGE)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Invalid write-combined region. <offset>:<size> is expected. %s is provided.", optarg);
+        s_uio_wc_args_valid = false;
+        return;
+    }
+
+    size = strtoul(endptr + 1, &endptr, 0);
+    if (*endptr != '\0' || size == 0 || errno == ERANGE)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Invalid write-combined region. <offset>:<size> is expected. %s is provided.", optarg);
+        s_uio_wc_args_valid = false;
+        return;
+    }
+
+    s_uio_wc_regions[s_uio_wc_region_count].offset = offset;
+    s_uio_wc_regions[s_uio_wc_region_count].size = size;
+    s_uio_wc_regions[s_uio_wc_region_count].mmap_ptr = NULL;
+    s_uio_wc_regions[s_uio_wc_region_count].mmap_size = 0;
+    ++s_uio_wc_region_count;
+}
+
 void uio_update_based_on_sysfs()
 {
 #ifndef UIO_UNIT_TEST_SW_MODEL_MODE
@@ -455,18 +617,16 @@ uint64_t uio_get_sysfs_map_file_to_uint64(const char *path)
 
     return ret;
 }
-void uio_get_sysfs_map_path(char *path, int path_buf_size)
+bool uio_get_driver_index(uint32_t *index)
 {
-    uint32_t index = 0;
     char *p;
     char *endptr;
 
-    path[0] = '\0';
     // The region index is encoded in the file name component.
     p = strrchr(s_uio_drv_path, '/');
     if (!p)
     {
-        return;
+        return false;
     }
 
     // p + 4 because the string will look like:
@@ -474,8 +634,21 @@ void uio_get_sysfs_map_path(char *path, int path_buf_size)
     // /dev/uio3
     endptr = NULL;
     p += 4;
-    index = strtoul(p, &endptr, 10);
+    *index = strtoul(p, &endptr, 10);
     if (*endptr)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void uio_get_sysfs_map_path(char *path, int path_buf_size)
+{
+    uint32_t index = 0;
+
+    path[0] = '\0';
+    if (!uio_get_driver_index(&index))
     {
         return;
     }
@@ -489,6 +662,75 @@ void uio_get_sysfs_map_path(char *path, int path_buf_size)
     }
 }
 
+#ifndef UIO_UNIT_TEST_SW_MODEL_MODE
+/*
+the write-combined alias of the PCI BAR backing map0, e.g. /sys/class/uio/uio0/device/resource2_wc, and the offset of
+the start of the map0 mapping within the BAR.  The BAR is the one of device/resource holding the physical address of
+map0; false if it cannot be found.
+*/
+bool uio_get_sysfs_wc_resource_path(char *path, int path_buf_size, size_t *bar_offset)
+{
+    enum
+    {
+        UIO_SYSFS_PATH_SIZE = 1024
+    };
+    char map_path[UIO_SYSFS_PATH_SIZE + 1];
+    char resource_path[UIO_SYSFS_PATH_SIZE + 1];
+    uint32_t index = 0;
+    uint64_t map_addr;
+    uint64_t map_offset;
+    uint64_t start;
+    uint64_t end;
+    uint64_t flags;
+    int bar = 0;
+    bool ret = false;
+    FILE *fp;
+
+    path[0] = '\0';
+    if (!uio_get_driver_index(&index))
+    {
+        return false;
+    }
+
+    // The mapping of map0 starts at the page holding its physical address; offset is the address within that page.
+    uio_get_sysfs_map_path(map_path, UIO_SYSFS_PATH_SIZE);
+    strncat(map_path, "addr", UIO_SYSFS_PATH_SIZE - strlen(map_path));
+    map_addr = uio_get_sysfs_map_file_to_uint64(map_path);
+    uio_get_sysfs_map_path(map_path, UIO_SYSFS_PATH_SIZE);
+    strncat(map_path, "offset", UIO_SYSFS_PATH_SIZE - strlen(map_path));
+    map_offset = uio_get_sysfs_map_file_to_uint64(map_path);
+    if (map_addr == 0 || map_offset > map_addr)
+    {
+        return false;
+    }
+
+    // One line per resource, BARs first: <start> <end> <flags>
+    snprintf(resource_path, UIO_SYSFS_PATH_SIZE, "/sys/class/uio/uio%d/device/resource", index);
+    fp = fopen(resource_path, "r");
+    if (fp == NULL)
+    {
+        return false;
+    }
+    while (fscanf(fp, "%lx %lx %lx", &start, &end, &flags) == 3)
+    {
+        if (start != 0 && map_addr >= start && map_addr <= end)
+        {
+            *bar_offset = (size_t)(map_addr - map_offset - start);
+            ret = snprintf(path, path_buf_size, "/sys/class/uio/uio%d/device/resource%d_wc", index, bar) > 0;
+            break;
+        }
+        bar++;
+    }
+    fclose(fp);
+
+    if (!ret)
+    {
+        path[0] = '\0';
+    }
+    return ret;
+}
+#endif
+
 bool uio_validate_args()
 {
     bool ret = s_uio_addr_span > 0 &&
@@ -505,7 +747,27 @@ bool uio_validate_args()
             fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "UIO driver path is not provided using the argument, --uio-driver-path.");
         }
     }
-    return ret;
+
+    if (ret)
+    {
+        unsigned int i;
+        for (i = 0; i < s_uio_wc_region_count; ++i)
+        {
+            if (s_uio_wc_regions[i].offset >= s_uio_addr_span || s_uio_wc_regions[i].size > s_uio_addr_span - s_uio_wc_regions[i].offset)
+            {
+                fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Write-combined region 0x%lX:0x%lX is not within the range based on the argument --address-span.", s_uio_wc_regions[i].offset, s_uio_wc_regions[i].size);
+                ret = false;
+            }
+        }
+    }
+
+    if (s_uio_dfl_mmio_access_param_id > UINT16_MAX)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "DFL MMIO access parameter ID 0x%lX is not a 16-bit parameter ID.", s_uio_dfl_mmio_access_param_id);
+        ret = false;
+    }
+
+    return ret && s_uio_wc_args_valid;
 }
 
 void uio_print_configuration()
@@ -520,6 +782,46 @@ void uio_print_configuration()
         fpga_msg_printf( FPGA_MSG_PRINTF_INFO, "   DFL Operation Model: %s", s_uio_single_component_mode ? "No" : "Yes");
         fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Entry Address: 0x%lX", s_dfl_entry_addr);
     }
+    for (unsigned int i = 0; i < s_uio_wc_region_count; ++i)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   Write-Combined Region: 0x%lX:0x%lX", s_uio_wc_regions[i].offset, s_uio_wc_regions[i].size);
+    }
+    if (s_uio_emulate_64bit)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   64-bit Access Emulation: Yes");
+    }
+    if (s_uio_dfl_rom_snapshot)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL ROM Snapshot: Yes");
+        if (s_uio_dfl_rom_snapshot_size > 0)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL ROM Snapshot Size: %ld", s_uio_dfl_rom_snapshot_size);
+        }
+    }
+    if (s_uio_dfl_param_views)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Parameter Views: Yes");
+    }
+    if (s_uio_dfl_cache_path != NULL)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Cache: %s", s_uio_dfl_cache_path);
+    }
+    if (s_uio_dfl_max_depth > 0)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Max Depth: %ld", s_uio_dfl_max_depth);
+    }
+    if (s_uio_dfl_max_interfaces > 0)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Max Interfaces: %ld", s_uio_dfl_max_interfaces);
+    }
+    if (s_uio_dfl_scan_workers > 1)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL Scan Workers: %ld", s_uio_dfl_scan_workers);
+    }
+    if (s_uio_dfl_mmio_access_param_id > 0)
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_INFO, "   DFL MMIO Access Parameter ID: 0x%lX", s_uio_dfl_mmio_access_param_id);
+    }
 }
 
 bool uio_open_driver()
@@ -579,8 +881,11 @@ bool uio_scan_interfaces()
         common_fpga_interface_info_vec_resize(1);
 
         common_fpga_interface_info_vec_at(0)->base_address = (void *)((char *)s_uio_mmap_ptr + s_uio_start_addr);
+        common_fpga_interface_info_vec_at(0)->address_span = s_uio_addr_span - s_uio_start_addr;
+        common_fpga_interface_info_vec_at(0)->emulate_64bit = s_uio_emulate_64bit != 0;
         common_fpga_interface_info_vec_at(0)->is_mmio_opened = false;
         common_fpga_interface_info_vec_at(0)->is_interrupt_opened = false;
+        common_fpga_interface_hot_update(0);
     }
     else
     {
@@ -588,12 +893,153 @@ bool uio_scan_interfaces()
 #ifdef DFL_WALKER_DEBUG_MODE
         fpga_msg_printf(FPGA_MSG_PRINTF_DEBUG, "Walking through multi-components mode with fisrt DFL address: 0x%lX", (size_t)first_dfh_addr);
 #endif
+        common_dfl_set_address_range(s_uio_mmap_ptr, s_uio_addr_span);
         common_dfl_scan_multi_interfaces(first_dfh_addr, uio_dfl_base_addr_decoder);
+        uio_update_address_spans();
+    }
+
+    return ret;
+}
+
+void uio_update_address_spans()
+{
+    size_t i;
+    char *map_end = (char *)s_uio_mmap_ptr + s_uio_addr_span;
+
+    // Each interface may be accessed up to the end of the UIO map; interfaces decoded outside of it get no span.
+    for (i = 0; i < common_fpga_interface_info_vec_size(); ++i)
+    {
+        char *base = (char *)common_fpga_interface_info_vec_at(i)->base_address;
+
+        common_fpga_interface_info_vec_at(i)->address_span = (base >= (char *)s_uio_mmap_ptr && base < map_end) ? (size_t)(map_end - base) : 0;
+    }
+}
+
+bool uio_add_wc_interfaces()
+{
+    bool ret = true;
+    unsigned int i;
+    void *uc_base;
+#ifndef UIO_UNIT_TEST_SW_MODEL_MODE
+    enum
+    {
+        UIO_WC_PATH_SIZE = 1024
+    };
+    char wc_path[UIO_WC_PATH_SIZE + 1];
+    size_t bar_offset = 0;
+
+    if (s_uio_wc_region_count == 0)
+    {
+        return ret;
+    }
+
+    if (!uio_get_sysfs_wc_resource_path(wc_path, UIO_WC_PATH_SIZE, &bar_offset))
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "No PCI BAR found for the UIO map.  Write-combined regions use the uncached mapping.");
+    }
+    s_uio_wc_drv_handle = wc_path[0] != '\0' ? open(wc_path, O_RDWR) : -1;
+    if (s_uio_wc_drv_handle == -1 && wc_path[0] != '\0')
+    {
+        fpga_msg_printf(FPGA_MSG_PRINTF_WARNING, "Failed to open %s.  Write-combined regions use the uncached mapping.", wc_path);
+    }
+    uc_base = s_uio_mmap_ptr;
+#else
+    // The software model has no device; the regions alias the model memory.
+    uc_base = common_fpga_interface_info_vec_at(0)->base_address;
+#endif
+
+    for (i = 0; i < s_uio_wc_region_count; ++i)
+    {
+        UIO_WC_REGION *region = &s_uio_wc_regions[i];
+        void *base = (char *)uc_base + region->offset;
+        size_t index;
+
+        // The uncached fallback aliases the UIO map, so a region must lie within it.
+        if (region->offset >= s_uio_addr_span || region->size > s_uio_addr_span - region->offset)
+        {
+            fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Write-combined region 0x%lX:0x%lX is outside of the UIO map of 0x%lX bytes.", region->offset, region->size, s_uio_addr_span);
+            ret = false;
+            break;
+        }
+
+#ifndef UIO_UNIT_TEST_SW_MODEL_MODE
+        if (s_uio_wc_drv_handle != -1)
+        {
+            size_t bar_region_offset = bar_offset + region->offset;
+            size_t map_offset = bar_region_offset & MASK_4K_ADDR;
+
+            region->mmap_size = region->size + (bar_region_offset - map_offset);
+            region->mmap_ptr = mmap(0, region->mmap_size, PROT_READ | PROT_WRITE, MAP_SHARED, s_uio_wc_drv_handle, map_offset);
+            if (region->mmap_ptr == MAP_FAILED)
+            {
+                fpga_msg_printf(FPGA_MSG_PRINTF_ERROR, "Failed to map the write-combined region 0x%lX:0x%lX.  (Error code %d)", region->offset, region->size, errno);
+                region->mmap_ptr = NULL;
+                ret = false;
+                break;
+            }
+            base = (char *)region->mmap_ptr + (bar_region_offset - map_offset);
+        }
+#endif
+
+        index = common_fpga_interface_info_vec_size();
+        common_fpga_interface_info_vec_resize(index + 1);
+        common_fpga_interface_info_vec_at(index)->base_address = base;
+        common_fpga_interface_info_vec_at(index)->dfh_parent = -1;
+        common_fpga_interface_info_vec_at(index)->write_combining = true;
+        common_fpga_interface_info_vec_at(index)->address_span = region->size;
+        common_fpga_interface_info_vec_at(index)->emulate_64bit = s_uio_emulate_64bit != 0;
+        common_fpga_interface_hot_update(index);
+        region->index = index;
+    }
+
+    return ret;
+}
+
+void uio_unmap_wc_regions()
+{
+    unsigned int i;
+
+    for (i = 0; i < s_uio_wc_region_count; ++i)
+    {
+        if (s_uio_wc_regions[i].mmap_ptr != NULL)
+        {
+            munmap(s_uio_wc_regions[i].mmap_ptr, s_uio_wc_regions[i].mmap_size);
+            s_uio_wc_regions[i].mmap_ptr = NULL;
+        }
+    }
+
+    if (s_uio_wc_drv_handle >= 0)
+    {
+        close(s_uio_wc_drv_handle);
+        s_uio_wc_drv_handle = -1;
+    }
+}
+
+unsigned int fpga_get_num_of_wc_regions()
+{
+    return s_uio_wc_region_count;
+}
+
+FPGA_MMIO_INTERFACE_HANDLE fpga_open_wc(unsigned int region)
+{
+    FPGA_MMIO_INTERFACE_HANDLE ret = FPGA_MMIO_INTERFACE_INVALID_HANDLE;
+
+    if (region < s_uio_wc_region_count)
+    {
+        ret = fpga_open(s_uio_wc_regions[region].index);
     }
 
     return ret;
 }
 
+void fpga_close_wc(unsigned int region)
+{
+    if (region < s_uio_wc_region_count)
+    {
+        fpga_close(s_uio_wc_regions[region].index);
+    }
+}
+
 bool uio_create_interrupt_thread()
 {
     bool ret;
@@ -630,6 +1076,9 @@ bool uio_create_unit_test_sw_model()
     common_fpga_interface_info_vec_resize(1);
 
     common_fpga_interface_info_vec_at(0)->base_address = malloc(s_uio_addr_span);
+    common_fpga_interface_info_vec_at(0)->address_span = s_uio_addr_span;
+    common_fpga_interface_info_vec_at(0)->emulate_64bit = s_uio_emulate_64bit != 0;
+    common_fpga_interface_hot_update(0);
     // Preset mem with all 1s
     memset(common_fpga_interface_info_vec_at(0)->base_address, 0xFF, s_uio_addr_span);
 
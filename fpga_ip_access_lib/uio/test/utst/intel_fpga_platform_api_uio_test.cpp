@@ -32,6 +32,7 @@ using namespace std;
 
 #include "gtest/gtest.h"
 
+#include "intel_fpga_api_uio.h"
 #include "intel_fpga_platform_api_uio.h"
 #include "intel_fpga_api_cmn_msg.h"
 
@@ -340,6 +341,37 @@ TEST_F(Argument, should_deal_with_valid_argument_with_optional_single_mode)
     fpga_platform_cleanup();
 }
 
+TEST_F(Argument, should_deal_with_valid_argument_with_short_emulate_64bit)
+{
+    const char *argv_valid[] =
+    {
+        "program",
+        "--single-component-mode",
+        "--uio-driver-path=/dev/uio0",
+        "--address-span=4096",
+        "-e"
+    };
+
+    bool rc = fpga_platform_init(5, argv_valid);
+    EXPECT_TRUE(rc);
+
+    EXPECT_STREQ(
+        "INFO: UIO Platform Configuration:"
+        "INFO:    Driver Path: /dev/uio0"
+        "INFO:    Address Span: 4096"
+        "INFO:    Start Address: 0x0"
+        "INFO:    Single Component Operation Model: Yes"
+        "INFO:    64-bit Access Emulation: Yes",
+        m_uio_msg_oss.str().c_str());
+
+    FPGA_MMIO_INTERFACE_HANDLE handle = fpga_open(0);
+    EXPECT_TRUE(handle != FPGA_MMIO_INTERFACE_INVALID_HANDLE);
+    EXPECT_TRUE(fpga_uio_is_64bit_emulated(handle));
+    fpga_close(0);
+
+    fpga_platform_cleanup();
+}
+
 TEST_F(Argument, should_deal_with_valid_argument_with_optional_start_addr)
 {
     const char *argv_valid[] =
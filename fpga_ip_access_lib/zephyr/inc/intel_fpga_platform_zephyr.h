@@ -104,8 +104,47 @@ typedef struct
     const struct device          *dev;
     bool                         dfl;
     void                         *dfl_base_address;
+    void                         *shadow;           // Register shadow created by fpga_shadow_add_range(); NULL if unused
+    bool                         emulate_64bit;     // Split 64-bit accesses into two 32-bit accesses; see fpga_set_64bit_emulation()
+    void                         *dfh_address;      // DFH describing the interface; NULL if not discovered from a DFL
+    uint32_t                     *param_order;      // Parameter positions sorted by param_id, highest version first; see fpga_get_parameter()
+    bool                         is_removed;        // Set by fpga_dfl_rescan() when the DFH is gone; the index is kept but cannot be opened
+    struct k_spinlock            lock;              // Lock taken by fpga_lock()
+    k_spinlock_key_t             lock_key;          // Key returned when fpga_lock() took the lock
 } FPGA_INTERFACE_INFO;
 
+typedef enum
+{
+    FPGA_MMIO_BATCH_WRITE,
+    FPGA_MMIO_BATCH_READ
+} FPGA_MMIO_BATCH_OP;
+
+typedef struct
+{
+    FPGA_MMIO_BATCH_OP           op;            //!< Read or write
+    uint32_t                     width;         //!< Access width in bits: 8, 16, 32 or 64
+    uint32_t                     offset;        //!< Byte offset from the base address of the MMIO interface
+    union
+    {
+        uint64_t                 value;         //!< Value to write for FPGA_MMIO_BATCH_WRITE
+        void                     *ptr;          //!< Destination of the width-sized value for FPGA_MMIO_BATCH_READ
+    };
+} FPGA_MMIO_BATCH_DESC;
+
+typedef enum
+{
+    FPGA_POLL_SPIN,                             //!< Spin with a CPU relax hint between reads until the timeout
+    FPGA_POLL_BACKOFF,                          //!< Spin briefly, then wait exponentially longer between reads and yield the CPU
+    FPGA_POLL_SLEEP                             //!< Spin briefly, then sleep exponentially longer between reads
+} FPGA_POLL_POLICY;
+
+typedef struct
+{
+    uint64_t                     elapsed_ns;    //!< Time spent polling
+    uint64_t                     read_count;    //!< Number of register reads issued
+    uint64_t                     value;         //!< Last value read
+} FPGA_POLL_RESULT;
+
 typedef void * FPGA_PLATFORM_PHYSICAL_MEM_ADDR_TYPE;
 
 #ifdef __cplusplus
@@ -26,10 +26,48 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <zephyr/irq.h>
 
 #include "intel_fpga_api_zephyr.h"
 #include "intel_fpga_api_cmn_msg.h"
+#include "intel_fpga_api_cmn_arch.h"
+
+// Busy-wait window before FPGA_POLL_BACKOFF and FPGA_POLL_SLEEP start to back off, and the back-off limits
+#define FPGA_POLL_SPIN_WINDOW_NS    2000
+#define FPGA_POLL_MAX_BUSY_WAIT_US  64
+#define FPGA_POLL_MAX_SLEEP_NS      1000000
+
+static uint64_t zephyr_poll_now_ns();
+static uint64_t zephyr_poll_read(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t width);
+
+uint64_t zephyr_poll_now_ns()
+{
+    return k_ticks_to_ns_floor64(k_uptime_ticks());
+}
+
+uint64_t zephyr_poll_read(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t width)
+{
+    uint64_t ret;
+
+    switch (width)
+    {
+        case 8:
+            ret = fpga_read_8(handle, offset);
+            break;
+        case 16:
+            ret = fpga_read_16(handle, offset);
+            break;
+        case 32:
+            ret = fpga_read_32(handle, offset);
+            break;
+        default:
+            ret = fpga_read_64(handle, offset);
+            break;
+    }
+
+    return ret;
+}
 
 void *fpga_malloc(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t size)
 {
@@ -49,6 +87,275 @@ FPGA_PLATFORM_PHYSICAL_MEM_ADDR_TYPE fpga_get_physical_address(void *address)
 
     return 0;
 }
+
+int fpga_mmio_batch(FPGA_MMIO_INTERFACE_HANDLE handle, const FPGA_MMIO_BATCH_DESC *desc, size_t count)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        // Resolve the interface once for the whole list, and order it after the prior memory stores.
+        FPGA_INTERFACE_INFO *info = common_fpga_interface_info_vec_at(handle);
+        volatile uint8_t *base = (volatile uint8_t *)fpga_zephyr_get_base_address(handle);
+        bool emulate_64bit = fpga_zephyr_is_64bit_emulated(handle);
+        size_t i;
+
+        common_mmio_before_write();
+        for (i = 0; i < count; ++i)
+        {
+            volatile uint8_t *addr = base + desc[i].offset;
+
+            if (desc[i].op == FPGA_MMIO_BATCH_WRITE)
+            {
+                switch (desc[i].width)
+                {
+                    case 8:
+                        *addr = (uint8_t)desc[i].value;
+                        break;
+                    case 16:
+                        *((volatile uint16_t *)addr) = (uint16_t)desc[i].value;
+                        break;
+                    case 32:
+                        if (info->dfl)
+                        {
+                            *((volatile uint32_t *)addr) = (uint32_t)desc[i].value;
+                        }
+                        else
+                        {
+                            syscon_write_reg(info->dev, desc[i].offset, (uint32_t)desc[i].value);
+                        }
+                        break;
+                    case 64:
+                        if (!emulate_64bit)
+                        {
+                            *((volatile uint64_t *)addr) = desc[i].value;
+                        }
+                        else
+                        {
+                            fpga_write_64_relaxed(handle, desc[i].offset, desc[i].value);
+                        }
+                        break;
+                    default:
+                        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid access width %u in batch entry %zu.", desc[i].width, i);
+                        return -1;
+                }
+            }
+            else if (desc[i].op == FPGA_MMIO_BATCH_READ)
+            {
+                switch (desc[i].width)
+                {
+                    case 8:
+                        *((uint8_t *)desc[i].ptr) = *addr;
+                        break;
+                    case 16:
+                        *((uint16_t *)desc[i].ptr) = *((volatile uint16_t *)addr);
+                        break;
+                    case 32:
+                        if (info->dfl)
+                        {
+                            *((uint32_t *)desc[i].ptr) = *((volatile uint32_t *)addr);
+                        }
+                        else
+                        {
+                            syscon_read_reg(info->dev, desc[i].offset, (uint32_t *)desc[i].ptr);
+                        }
+                        break;
+                    case 64:
+                        if (!emulate_64bit)
+                        {
+                            *((uint64_t *)desc[i].ptr) = *((volatile uint64_t *)addr);
+                        }
+                        else
+                        {
+                            *((uint64_t *)desc[i].ptr) = fpga_read_64_relaxed(handle, desc[i].offset);
+                        }
+                        break;
+                    default:
+                        fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid access width %u in batch entry %zu.", desc[i].width, i);
+                        return -1;
+                }
+            }
+            else
+            {
+                fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid operation %d in batch entry %zu.", desc[i].op, i);
+                return -1;
+            }
+        }
+
+        // Only one barrier for the whole list; the accesses above are relaxed.
+        common_mmio_mb();
+        ret = 0;
+    }
+
+    return ret;
+}
+int fpga_read_block(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, void *dst, size_t len)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        uint8_t *data = (uint8_t *)dst;
+        uint16_t data_16;
+        uint32_t data_32;
+
+        // Nios V is a 32-bit core, so the aligned middle is streamed with 32-bit reads.
+        if ((offset & 1) && len >= 1)
+        {
+            *data = fpga_read_8(handle, offset);
+            offset += 1; data += 1; len -= 1;
+        }
+        if ((offset & 2) && len >= 2)
+        {
+            data_16 = fpga_read_16(handle, offset);
+            memcpy(data, &data_16, 2);
+            offset += 2; data += 2; len -= 2;
+        }
+        while (len >= 4)
+        {
+            data_32 = fpga_read_32(handle, offset);
+            memcpy(data, &data_32, 4);
+            offset += 4; data += 4; len -= 4;
+        }
+        if (len & 2)
+        {
+            data_16 = fpga_read_16(handle, offset);
+            memcpy(data, &data_16, 2);
+            offset += 2; data += 2;
+        }
+        if (len & 1)
+        {
+            *data = fpga_read_8(handle, offset);
+        }
+
+        ret = 0;
+    }
+
+    return ret;
+}
+
+int fpga_write_block(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, const void *src, size_t len)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        const uint8_t *data = (const uint8_t *)src;
+        uint16_t data_16;
+        uint32_t data_32;
+
+        if ((offset & 1) && len >= 1)
+        {
+            fpga_write_8(handle, offset, *data);
+            offset += 1; data += 1; len -= 1;
+        }
+        if ((offset & 2) && len >= 2)
+        {
+            memcpy(&data_16, data, 2);
+            fpga_write_16(handle, offset, data_16);
+            offset += 2; data += 2; len -= 2;
+        }
+        while (len >= 4)
+        {
+            memcpy(&data_32, data, 4);
+            fpga_write_32(handle, offset, data_32);
+            offset += 4; data += 4; len -= 4;
+        }
+        if (len & 2)
+        {
+            memcpy(&data_16, data, 2);
+            fpga_write_16(handle, offset, data_16);
+            offset += 2; data += 2;
+        }
+        if (len & 1)
+        {
+            fpga_write_8(handle, offset, *data);
+        }
+
+        ret = 0;
+    }
+
+    return ret;
+}
+
+int fpga_poll_until(FPGA_MMIO_INTERFACE_HANDLE handle, uint32_t offset, uint32_t width, uint64_t mask, uint64_t value,
+                    uint64_t timeout_ns, FPGA_POLL_POLICY policy, FPGA_POLL_RESULT *result)
+{
+    int ret = -1;
+    if (handle >= 0 && (size_t)handle < common_fpga_interface_info_vec_size() )
+    {
+        uint64_t start_ns;
+        uint64_t elapsed_ns;
+        uint64_t read_count = 0;
+        uint64_t data;
+        uint32_t busy_wait_us = 1;
+        uint64_t sleep_ns = 1000;
+
+        if (width != 8 && width != 16 && width != 32 && width != 64)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid access width %u.", width);
+            return -1;
+        }
+        if (policy != FPGA_POLL_SPIN && policy != FPGA_POLL_BACKOFF && policy != FPGA_POLL_SLEEP)
+        {
+            fpga_throw_runtime_exception(__FUNCTION__, __FILE__, __LINE__, "invalid polling policy %d.", policy);
+            return -1;
+        }
+
+        start_ns = zephyr_poll_now_ns();
+        for (;;)
+        {
+            data = zephyr_poll_read(handle, offset, width);
+            ++read_count;
+            elapsed_ns = zephyr_poll_now_ns() - start_ns;
+            if ((data & mask) == value)
+            {
+                ret = 0;
+                break;
+            }
+            if (elapsed_ns >= timeout_ns)
+            {
+                ret = 1;
+                break;
+            }
+
+            if (policy == FPGA_POLL_SPIN || elapsed_ns < FPGA_POLL_SPIN_WINDOW_NS)
+            {
+                common_cpu_relax();
+            }
+            else if (policy == FPGA_POLL_BACKOFF)
+            {
+                // Double the gap between reads; once it is capped, give the CPU away between reads as well.
+                k_busy_wait(busy_wait_us);
+                if (busy_wait_us < FPGA_POLL_MAX_BUSY_WAIT_US)
+                {
+                    busy_wait_us <<= 1;
+                }
+                else
+                {
+                    k_yield();
+                }
+            }
+            else
+            {
+                uint64_t remaining_ns = timeout_ns - elapsed_ns;
+
+                k_sleep(K_NSEC(sleep_ns < remaining_ns ? sleep_ns : remaining_ns));
+                if (sleep_ns < FPGA_POLL_MAX_SLEEP_NS)
+                {
+                    sleep_ns <<= 1;
+                }
+            }
+        }
+
+        if (result != NULL)
+        {
+            result->elapsed_ns = elapsed_ns;
+            result->read_count = read_count;
+            result->value = data;
+        }
+    }
+
+    return ret;
+}
+
 int fpga_register_isr(FPGA_INTERRUPT_HANDLE handle, FPGA_ISR isr, void *isr_context)
 {
     int ret = -1;
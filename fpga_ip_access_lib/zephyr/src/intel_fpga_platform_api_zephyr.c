@@ -40,6 +40,7 @@
 
 #include "intel_fpga_api_cmn_msg.h"
 #include "intel_fpga_api_cmn_dfl.h"
+#include "intel_fpga_api_cmn_index.h"
 #include "intel_fpga_api_zephyr.h"
 #include "intel_fpga_platform_zephyr.h"
 #include "intel_fpga_platform_api_zephyr.h"
@@ -265,6 +266,7 @@ bool zephyr_scan_interfaces()
     uint32_t index = 0;
     uint8_t  discovered_dev_n = ARRAY_SIZE(fpga_ip_access_dev_table);
     void *first_dfh_addr = NULL;
+    FPGA_DFL_SCAN_CTX dfl_scan_ctx;
 
     if( discovered_dev_n > 0)
     {
@@ -280,6 +282,7 @@ bool zephyr_scan_interfaces()
             common_fpga_interface_info_vec_at(0)->irq = fpga_ip_access_dev_table[0].irq;
             common_fpga_interface_info_vec_at(0)->is_mmio_opened = false;
             common_fpga_interface_info_vec_at(0)->is_interrupt_opened = false;
+            common_fpga_interface_hot_update(0);
 
             printk("SINGLE COMPONENT MODE : Only 1 device can be used!\n");
         }
@@ -304,20 +307,26 @@ bool zephyr_scan_interfaces()
 						common_fpga_interface_info_vec_at(index)->irq = fpga_ip_access_dev_table[n].irq;
 						common_fpga_interface_info_vec_at(index)->is_mmio_opened = false;
 						common_fpga_interface_info_vec_at(index)->is_interrupt_opened = false;
+						common_fpga_interface_hot_update(index);
 						break;
 
 					case 2:
-                        // Assume DFL rom start at index 0
-                        // Only support 1 DFL rom
-                        if(s_zephyr_dfl_found == true)
-                            return ret;
+                        // Each DFL ROM is walked within its own register range and its interfaces are appended
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
                         first_dfh_addr = (void *)(fpga_ip_access_dev_table[n].base_addr + s_zephyr_start_addr);
 #pragma GCC diagnostic pop
-                        s_zephyr_dfl_addr = fpga_ip_access_dev_table[n].base_addr;
-                        s_zephyr_dfl_found = true;
-						common_dfl_scan_multi_interfaces(first_dfh_addr, zephyr_dfl_base_addr_decoder);
+                        if(s_zephyr_dfl_found == false)
+                        {
+                            s_zephyr_dfl_addr = fpga_ip_access_dev_table[n].base_addr;  // the interfaces are reported relative to the first ROM
+                            s_zephyr_dfl_found = true;
+                        }
+                        common_dfl_scan_ctx_init(&dfl_scan_ctx);
+                        dfl_scan_ctx.range_begin = (uint8_t *)first_dfh_addr;
+                        dfl_scan_ctx.range_size = fpga_ip_access_dev_table[n].size;
+                        common_dfl_scan_ctx_walk(&dfl_scan_ctx, first_dfh_addr);
+                        common_dfl_scan_ctx_merge(&dfl_scan_ctx);
+                        common_dfl_scan_ctx_cleanup(&dfl_scan_ctx);
 					break;
 
 					default:
@@ -325,6 +334,7 @@ bool zephyr_scan_interfaces()
 
 				}
             }
+            common_index_build();
         }
         ret = true;
     }
@@ -338,6 +348,7 @@ bool zephyr_create_unit_test_sw_model()
     common_fpga_interface_info_vec_resize(1);
 
     common_fpga_interface_info_vec_at(0)->base_address = malloc(s_zephyr_addr_span);
+    common_fpga_interface_hot_update(0);
     // Preset mem with all 1s
     memset(common_fpga_interface_info_vec_at(0)->base_address, 0xFF, s_zephyr_addr_span);
 